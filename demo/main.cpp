@@ -6,10 +6,30 @@
 #include <algorithm>
 #include <iostream>
 #include <type_traits>
+#include <sstream>
+#include <string>
 
 #include "LazyStrIterator.hpp"
 #include "ph.hpp"
 #include "algorithm.hpp"
+#include "adaptors.hpp"
+#include "parallel.hpp"
+#include "DelimiterIndex.hpp"
+#include "generator.hpp"
+#include "dynamic_sentinel.hpp"
+#include "ValueSet.hpp"
+#include "substring.hpp"
+#include "scanner.hpp"
+#include "watermark.hpp"
+#include "interrupt.hpp"
+#include "numeric.hpp"
+#include "flat_map.hpp"
+#include "set_bits.hpp"
+#include <functional>
+#include <map>
+#include <unordered_set>
+#include <mutex>
+#include <thread>
 
 int main() {
 
@@ -33,6 +53,14 @@ int main() {
 		i = intDis(gen);
 	}
 
+	std::string csv;
+	for(int row = 0; row < 1000; ++row) {
+		for(int column = 0; column < 8; ++column) {
+			csv += std::to_string(dis(gen) * row);
+			csv += column < 7 ? ',' : '\n';
+		}
+	}
+
 	const int runs = 10000;
 
 	// test vars complete. now for testing.
@@ -179,8 +207,902 @@ int main() {
 
 		}
 
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+
+			std::istringstream stream(csv);
+			std::string field;
+			std::size_t fields = 0;
+			while(std::getline(stream, field, ',')) {
+				++fields;
+			}
+
+			auto end = std::chrono::high_resolution_clock::now();
+			//std::cout << "std::getline split: " << (end - start).count() << std::endl;
+
+		}
+
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+
+			std::string copy = csv;
+			char* state = nullptr;
+			std::size_t fields = 0;
+			for(char* field = strtok_r(&copy[0], ",\n", &state); field;
+					field = strtok_r(nullptr, ",\n", &state)) {
+				++fields;
+			}
+
+			auto end = std::chrono::high_resolution_clock::now();
+			//std::cout << "strtok_r split: " << (end - start).count() << std::endl;
+
+		}
+
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+
+			auto range = ph::make_iterator_range(csv.c_str(), ph::LazyStrIterator{}) |
+				ph::adaptor::split(ph::untilValue(',', '\n'));
+			auto fields = ph::distance(range.begin(), range.end());
+
+			auto end = std::chrono::high_resolution_clock::now();
+			//std::cout << "ph::adaptor::split: " << (end - start).count() << std::endl;
+
+		}
+
 	} // for run <= runs.
 
-}
+	std::string log(64 * 1024 * 1024, 'x');
+	for(std::size_t i = 0; i < log.size(); i += 80 + i % 61) {
+		log[i] = '\n';
+	}
+
+	for(unsigned threads = 1; threads <= 64; threads *= 2) {
+		auto start = std::chrono::high_resolution_clock::now();
+
+		std::size_t records = 0;
+		ph::parallel_split(log.data(), log.data() + log.size(), ph::untilValue('\n'), threads,
+				[&records](const ph::Range<const char*, const char*>&) { ++records; });
+
+		auto end = std::chrono::high_resolution_clock::now();
+		//std::cout << "ph::parallel_split with " << threads << " threads: " << (end - start).count() << std::endl;
+	}
+
+	{
+		auto start = std::chrono::high_resolution_clock::now();
+
+		ph::DelimiterIndex index(log.data(), log.data() + log.size(), {'\n', ','});
+
+		auto end = std::chrono::high_resolution_clock::now();
+		//std::cout << "ph::DelimiterIndex build: " << (end - start).count() << std::endl;
+
+		for(int query = 0; query < 32; ++query) {
+			const char* from = log.data() + query * (log.size() / 32);
+
+			auto startScan = std::chrono::high_resolution_clock::now();
+			auto countScan = ph::count(from, ph::untilValue(',') || (log.data() + log.size()), '\n');
+			auto endScan = std::chrono::high_resolution_clock::now();
+			//std::cout << "ph::count scan: " << (endScan - startScan).count() << std::endl;
+
+			auto startIndexed = std::chrono::high_resolution_clock::now();
+			auto countIndexed = ph::count(from, index.untilValue(','), '\n');
+			auto endIndexed = std::chrono::high_resolution_clock::now();
+			//std::cout << "ph::count indexed: " << (endIndexed - startIndexed).count() << std::endl;
+
+			assert(countScan == countIndexed);
+		}
+	}
+
+	{
+		const int elements = 100000000;
+
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+
+			std::vector<int> materialised;
+			std::minstd_rand decoder(42);
+			for(int i = 0; i < elements; ++i) {
+				materialised.push_back(decoder() % 1000);
+			}
+			auto count = ph::count(materialised.begin(), ph::untilValue(1000) || materialised.end(), 7);
+
+			auto end = std::chrono::high_resolution_clock::now();
+			//std::cout << "materialise then ph::count: " << (end - start).count()
+			//	<< ", bytes: " << materialised.capacity() * sizeof(int) << std::endl;
+		}
+
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+
+			std::minstd_rand decoder(42);
+			int produced = 0;
+			auto g = ph::make_generator<int>([&](int& out) {
+				out = decoder() % 1000;
+				return produced++ < elements;
+			});
+			auto count = ph::count(g.begin(), ph::untilValue(1000) || g.end(), 7);
+
+			auto end = std::chrono::high_resolution_clock::now();
+			//std::cout << "ph::generator then ph::count: " << (end - start).count()
+			//	<< ", bytes: " << sizeof(g) << std::endl;
+		}
+	}
+
+	for(std::size_t batch: {1, 16, 256, 4096}) {
+		std::vector<int> decoded(10000000);
+
+		auto start = std::chrono::high_resolution_clock::now();
+
+		auto range = ph::make_iterator_range(decoded.begin(), decoded.end()) |
+			ph::adaptor::filtered([](const int& i) { return i % 2 == 0; }) |
+			ph::adaptor::async_buffered(16384, batch);
+
+		auto first = range.begin();
+		auto firstElement = std::chrono::high_resolution_clock::now();
+
+		long long sum = 0;
+		ph::for_each(first, range.end(), [&sum](int i) { sum += i; });
+
+		auto end = std::chrono::high_resolution_clock::now();
+		//std::cout << "async_buffered batch " << batch << " latency: " << (firstElement - start).count()
+		//	<< ", throughput time: " << (end - start).count() << std::endl;
+	}
+
+	{
+		const std::string configured = "100 || 200 || (>= 500000 && < 500100)";
+
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+
+			std::vector<std::function<bool(int)>> chain = {
+				[](int i) { return i == 100; },
+				[](int i) { return i == 200; },
+				[](int i) { return i >= 500000 && i < 500100; },
+			};
+			auto it = ph::find(v.begin(), ph::until([&chain](const int& i) {
+				for(auto& f: chain) {
+					if(f(i)) {
+						return true;
+					}
+				}
+				return false;
+			}) || v.end(), -1);
+
+			auto end = std::chrono::high_resolution_clock::now();
+			//std::cout << "std::function chain: " << (end - start).count() << std::endl;
+		}
+
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+
+			ph::dynamic_sentinel<int> stop(configured);
+			auto it = ph::find(v.begin(), stop || v.end(), -1);
+
+			auto end = std::chrono::high_resolution_clock::now();
+			//std::cout << "ph::dynamic_sentinel: " << (end - start).count() << std::endl;
+		}
+	}
+
+	for(std::size_t setSize: {1, 10, 100, 1000, 10000, 100000}) {
+		// None of these is in v, so every element is probed.
+		std::vector<int> stops(setSize);
+		for(std::size_t i = 0; i < setSize; ++i) {
+			stops[i] = Size + static_cast<int>(i) * 37;
+		}
+
+		{
+			std::unordered_set<int> hashed(stops.begin(), stops.end());
+
+			auto start = std::chrono::high_resolution_clock::now();
+
+			auto it = ph::find(v.begin(), ph::until([&hashed](const int& i) { return hashed.count(i) != 0; }) || v.end(), -1);
+
+			auto end = std::chrono::high_resolution_clock::now();
+			//std::cout << "std::unordered_set " << setSize << ": " << double((end - start).count()) / Size << " per element" << std::endl;
+		}
+
+		for(auto representation: { ph::ValueSetRepresentation::Bitmap, ph::ValueSetRepresentation::Hash,
+				ph::ValueSetRepresentation::Sorted }) {
+			auto stop = ph::untilAnyOf(stops, representation);
+
+			auto start = std::chrono::high_resolution_clock::now();
+
+			auto it = ph::find(v.begin(), stop || v.end(), -1);
+
+			auto end = std::chrono::high_resolution_clock::now();
+			//std::cout << "ph::untilAnyOf " << setSize << " (" << static_cast<int>(representation) << "): "
+			//	<< double((end - start).count()) / Size << " per element" << std::endl;
+		}
+	}
+
+	{
+		std::string text(1 << 26, 'a');
+		for(auto& c: text) {
+			c = static_cast<char>('a' + dis(gen) % 26);
+		}
+		text.replace(text.size() - 12, 10, "--boundary");
+
+		for(std::size_t patternCount: {1, 4, 50}) {
+			std::vector<std::string> patterns = { "--boundary" };
+			for(std::size_t i = 1; i < patternCount; ++i) {
+				patterns.push_back("</record" + std::to_string(i) + ">");
+			}
+
+			{
+				auto start = std::chrono::high_resolution_clock::now();
+
+				const char* first = text.data() + text.size();
+				for(const auto& p: patterns) {
+					const void* found = memmem(text.data(), text.size(), p.data(), p.size());
+					if(found && static_cast<const char*>(found) < first) {
+						first = static_cast<const char*>(found);
+					}
+				}
+
+				auto end = std::chrono::high_resolution_clock::now();
+				//std::cout << "repeated memmem " << patternCount << ": " << (end - start).count() << std::endl;
+			}
+
+			{
+				auto start = std::chrono::high_resolution_clock::now();
 
+				ph::SubstringNode stop(patterns);
+				auto it = ph::next(text.data(), text.data() + text.size() || stop);
 
+				auto end = std::chrono::high_resolution_clock::now();
+				//std::cout << "ph::untilSubstring " << patternCount << ": " << (end - start).count() << std::endl;
+			}
+		}
+	}
+
+	{
+		std::string record(1 << 22, 'x');
+		record += "\r\n\r\n";
+
+		for(std::size_t fragment: {64, 1024, 65536, 1 << 22}) {
+			{
+				auto start = std::chrono::high_resolution_clock::now();
+
+				auto s = ph::make_scanner(ph::untilSubstring("\r\n\r\n"));
+				for(std::size_t at = 0; at < record.size() && !s.found(); at += fragment) {
+					s.next(record.data() + at, record.data() + std::min(record.size(), at + fragment));
+				}
+
+				auto end = std::chrono::high_resolution_clock::now();
+				//std::cout << "ph::scanner fragment " << fragment << ": " << (end - start).count() << std::endl;
+			}
+
+			if(fragment >= 65536) {
+				auto start = std::chrono::high_resolution_clock::now();
+
+				// Rescanning the record from its start on every fragment.
+				for(std::size_t at = fragment; ; at += fragment) {
+					const std::size_t received = std::min(record.size(), at);
+					if(memmem(record.data(), received, "\r\n\r\n", 4) || received == record.size()) {
+						break;
+					}
+				}
+
+				auto end = std::chrono::high_resolution_clock::now();
+				//std::cout << "rescanning memmem fragment " << fragment << ": " << (end - start).count() << std::endl;
+			}
+		}
+	}
+
+	for(std::size_t consumerCount: {1, 2, 4, 8}) {
+		const std::size_t total = 1 << 25;
+		const std::size_t chunk = 4096;
+		std::vector<int> growing(total);
+
+		{
+			ph::Watermark w;
+
+			auto start = std::chrono::high_resolution_clock::now();
+
+			std::thread producer([&growing, &w, total, chunk]() {
+				for(std::size_t i = 0; i < total; ++i) {
+					growing[i] = static_cast<int>(i);
+					if((i + 1) % chunk == 0) {
+						w.publish(i + 1);
+					}
+				}
+				w.publish(total);
+				w.close();
+			});
+			std::vector<std::thread> consumers;
+			for(std::size_t c = 0; c < consumerCount; ++c) {
+				consumers.emplace_back([&growing, &w]() {
+					long long sum = 0;
+					ph::for_each(growing.begin(), ph::make_watermark_sentinel(growing.begin(), w, ph::WatermarkWait::Yield),
+							[&sum](int i) { sum += i; });
+				});
+			}
+			producer.join();
+			for(auto& t: consumers) {
+				t.join();
+			}
+
+			auto end = std::chrono::high_resolution_clock::now();
+			//std::cout << "ph::watermark_sentinel " << consumerCount << " consumers: " << (end - start).count() << std::endl;
+		}
+
+		{
+			std::mutex mutex;
+			std::size_t published = 0;
+			bool closed = false;
+
+			auto start = std::chrono::high_resolution_clock::now();
+
+			std::thread producer([&]() {
+				for(std::size_t i = 0; i < total; ++i) {
+					growing[i] = static_cast<int>(i);
+					if((i + 1) % chunk == 0) {
+						std::lock_guard<std::mutex> lock(mutex);
+						published = i + 1;
+					}
+				}
+				std::lock_guard<std::mutex> lock(mutex);
+				published = total;
+				closed = true;
+			});
+			std::vector<std::thread> consumers;
+			for(std::size_t c = 0; c < consumerCount; ++c) {
+				consumers.emplace_back([&]() {
+					long long sum = 0;
+					std::size_t position = 0;
+					for(;;) {
+						std::size_t snapshot;
+						bool done;
+						{
+							std::lock_guard<std::mutex> lock(mutex);
+							snapshot = published;
+							done = closed;
+						}
+						std::for_each(growing.begin() + position, growing.begin() + snapshot, [&sum](int i) { sum += i; });
+						position = snapshot;
+						if(done && position == total) {
+							break;
+						}
+						std::this_thread::yield();
+					}
+				});
+			}
+			producer.join();
+			for(auto& t: consumers) {
+				t.join();
+			}
+
+			auto end = std::chrono::high_resolution_clock::now();
+			//std::cout << "mutex snapshots " << consumerCount << " consumers: " << (end - start).count() << std::endl;
+		}
+	}
+
+	{
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::hours(1);
+
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+
+			auto it = ph::find(v.begin(), v.end() || ph::until([&deadline](const int&) {
+				return std::chrono::steady_clock::now() > deadline;
+			}), -1);
+
+			auto end = std::chrono::high_resolution_clock::now();
+			//std::cout << "clock per element: " << (end - start).count() << std::endl;
+		}
+
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+
+			auto it = ph::find(v.begin(), v.end() || ph::until_deadline(deadline), -1);
+
+			auto end = std::chrono::high_resolution_clock::now();
+			//std::cout << "ph::until_deadline: " << (end - start).count() << std::endl;
+		}
+
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+
+			auto it = ph::find(v.begin(), v.end(), -1);
+
+			auto end = std::chrono::high_resolution_clock::now();
+			//std::cout << "no deadline: " << (end - start).count() << std::endl;
+		}
+	}
+
+	{
+		std::vector<int> ids(1 << 24);
+		for(std::size_t i = 0; i < ids.size(); ++i) {
+			ids[i] = static_cast<int>(2 * i + 1);
+		}
+		ids.back() = 0;
+
+		for(int distance: {10, 1000, 1000000}) {
+			const int value = 2 * distance;
+
+			{
+				auto start = std::chrono::high_resolution_clock::now();
+
+				auto it = ph::find_if(ids.begin(), ph::untilValue(0), [value](int i) { return !(i < value); });
+
+				auto end = std::chrono::high_resolution_clock::now();
+				//std::cout << "linear lower_bound " << distance << ": " << (end - start).count() << std::endl;
+			}
+
+			{
+				auto start = std::chrono::high_resolution_clock::now();
+
+				auto last = ph::next(ids.begin(), ph::untilValue(0));
+				auto it = std::lower_bound(ids.begin(), last, value);
+
+				auto end = std::chrono::high_resolution_clock::now();
+				//std::cout << "length + std::lower_bound " << distance << ": " << (end - start).count() << std::endl;
+			}
+
+			{
+				auto start = std::chrono::high_resolution_clock::now();
+
+				auto it = ph::lower_bound(ids.begin(), ph::untilValue(0), value);
+
+				auto end = std::chrono::high_resolution_clock::now();
+				//std::cout << "ph::lower_bound sentinel " << distance << ": " << (end - start).count() << std::endl;
+			}
+
+			{
+				auto start = std::chrono::high_resolution_clock::now();
+
+				auto it = ph::lower_bound(ids.begin(), ph::counted(ids.size() - 1), value);
+
+				auto end = std::chrono::high_resolution_clock::now();
+				//std::cout << "ph::lower_bound counted " << distance << ": " << (end - start).count() << std::endl;
+			}
+		}
+	}
+
+	for(int ratio: {1, 10, 100, 1000, 10000}) {
+		const std::size_t largeSize = 1 << 22;
+		std::vector<int> large(largeSize + 1);
+		std::vector<int> small(largeSize / ratio + 1);
+		for(std::size_t i = 0; i < largeSize; ++i) {
+			large[i] = static_cast<int>(2 * i + 1);
+		}
+		for(std::size_t i = 0; i + 1 < small.size(); ++i) {
+			small[i] = static_cast<int>(2 * i * ratio + 1 + (i % 2));
+		}
+		large.back() = 0;
+		small.back() = 0;
+
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+
+			std::vector<int> copy1(large.begin(), ph::next(large.begin(), ph::untilValue(0)));
+			std::vector<int> copy2(small.begin(), ph::next(small.begin(), ph::untilValue(0)));
+			std::vector<int> result;
+			std::set_intersection(copy1.begin(), copy1.end(), copy2.begin(), copy2.end(), std::back_inserter(result));
+
+			auto end = std::chrono::high_resolution_clock::now();
+			//std::cout << "copy + std::set_intersection 1:" << ratio << ": " << (end - start).count() << std::endl;
+		}
+
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+
+			std::vector<int> result;
+			ph::set_intersection(small.begin(), ph::untilValue(0), large.begin(), ph::untilValue(0), std::back_inserter(result));
+
+			auto end = std::chrono::high_resolution_clock::now();
+			//std::cout << "ph::set_intersection sentinel 1:" << ratio << ": " << (end - start).count() << std::endl;
+		}
+
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+
+			std::vector<int> result;
+			ph::set_intersection(small.data(), ph::counted(small.size() - 1), large.data(), ph::counted(largeSize), std::back_inserter(result));
+
+			auto end = std::chrono::high_resolution_clock::now();
+			//std::cout << "ph::set_intersection counted 1:" << ratio << ": " << (end - start).count() << std::endl;
+		}
+	}
+
+	{
+		// Eight sorted shards, each with its own kind of end.
+		const std::size_t shardSize = 1 << 18;
+		std::vector<std::vector<int>> shards(8);
+		for(std::size_t i = 0; i < 8 * shardSize; ++i) {
+			shards[i % 8].push_back(static_cast<int>(i * 2654435761u % 1000000007u));
+		}
+		for(auto& shard: shards) {
+			std::sort(shard.begin(), shard.end());
+			shard.push_back(-1);
+		}
+
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+
+			std::vector<int> all;
+			for(auto& shard: shards) {
+				all.insert(all.end(), shard.begin(), ph::next(shard.begin(), ph::untilValue(-1)));
+			}
+			std::sort(all.begin(), all.end());
+
+			auto end = std::chrono::high_resolution_clock::now();
+			//std::cout << "copy + std::sort 8 shards: " << (end - start).count() << std::endl;
+		}
+
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+
+			auto range = [&shards](std::size_t i) { return ph::make_iterator_range(shards[i].begin(), ph::untilValue(-1)); };
+			auto all = ph::adaptor::merged(range(0), range(1), range(2), range(3), range(4), range(5), range(6), range(7));
+			std::vector<int> merged;
+			ph::copy(all.begin(), all.end(), std::back_inserter(merged));
+
+			auto end = std::chrono::high_resolution_clock::now();
+			//std::cout << "ph::adaptor::merged 8 shards: " << (end - start).count() << std::endl;
+		}
+	}
+
+	{
+		std::vector<float> values(1 << 24);
+		for(std::size_t i = 0; i < values.size(); ++i) {
+			values[i] = static_cast<float>(i % 1000) * 0.001f + 1.0f;
+		}
+		values.back() = 0.0f;
+
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+
+			float sum = 0.0f;
+			ph::for_each(values.data(), ph::untilValue(0.0f), [&sum](float f) { sum += f; });
+
+			auto end = std::chrono::high_resolution_clock::now();
+			//std::cout << "ph::for_each sum " << sum << ": " << (end - start).count() << std::endl;
+		}
+
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+
+			float sum = ph::accumulate(values.data(), ph::untilValue(0.0f), 0.0f);
+
+			auto end = std::chrono::high_resolution_clock::now();
+			//std::cout << "ph::accumulate " << sum << ": " << (end - start).count() << std::endl;
+		}
+
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+
+			float sum = ph::reduce(values.data(), ph::untilValue(0.0f), 0.0f);
+
+			auto end = std::chrono::high_resolution_clock::now();
+			//std::cout << "ph::reduce sentinel " << sum << ": " << (end - start).count() << std::endl;
+		}
+
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+
+			float sum = ph::reduce(values.data(), ph::counted(values.size() - 1), 0.0f);
+
+			auto end = std::chrono::high_resolution_clock::now();
+			//std::cout << "ph::reduce counted " << sum << ": " << (end - start).count() << std::endl;
+		}
+
+		for(unsigned threads: {2u, 4u, 8u}) {
+			auto start = std::chrono::high_resolution_clock::now();
+
+			float sum = ph::parallel_reduce(values.data(), ph::untilValue(0.0f), 0.0f, threads);
+
+			auto end = std::chrono::high_resolution_clock::now();
+			//std::cout << "ph::parallel_reduce " << threads << " threads " << sum << ": " << (end - start).count() << std::endl;
+		}
+	}
+
+	{
+		std::vector<int> values(1 << 24);
+		std::mt19937 generator(7);
+		for(auto& value: values) {
+			value = static_cast<int>(generator() % 1000000) + 1;
+		}
+		values.back() = 0;
+
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+
+			auto min = ph::min_element(values.data(), ph::untilValue(0));
+			auto max = ph::max_element(values.data(), ph::untilValue(0));
+
+			auto end = std::chrono::high_resolution_clock::now();
+			//std::cout << "ph::min_element + ph::max_element " << *min << " " << *max << ": " << (end - start).count() << std::endl;
+		}
+
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+
+			auto extremes = std::minmax_element(values.begin(), values.end() - 1);
+
+			auto end = std::chrono::high_resolution_clock::now();
+			//std::cout << "std::minmax_element " << *extremes.first << " " << *extremes.second << ": " << (end - start).count() << std::endl;
+		}
+
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+
+			auto extremes = ph::minmax_element(values.begin(), ph::untilValue(0));
+
+			auto end = std::chrono::high_resolution_clock::now();
+			//std::cout << "ph::minmax_element iterator " << *extremes.first << " " << *extremes.second << ": " << (end - start).count() << std::endl;
+		}
+
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+
+			auto extremes = ph::minmax_element(values.data(), ph::untilValue(0));
+
+			auto end = std::chrono::high_resolution_clock::now();
+			//std::cout << "ph::minmax_element pointer " << *extremes.first << " " << *extremes.second << ": " << (end - start).count() << std::endl;
+		}
+	}
+
+	{
+		std::vector<int> stream(1 << 24);
+		std::mt19937 generator(11);
+		for(auto& value: stream) {
+			value = static_cast<int>(generator() % 1000000000) + 1;
+		}
+		stream.back() = 0;
+
+		for(std::size_t k: {1u, 10u, 100u, 1000u, 10000u}) {
+			{
+				auto start = std::chrono::high_resolution_clock::now();
+
+				std::vector<int> copy(stream.begin(), ph::next(stream.begin(), ph::untilValue(0)));
+				std::partial_sort(copy.begin(), copy.begin() + k, copy.end(), std::greater<int>());
+				copy.resize(k);
+
+				auto end = std::chrono::high_resolution_clock::now();
+				//std::cout << "copy + std::partial_sort k = " << k << ": " << (end - start).count() << std::endl;
+			}
+
+			{
+				auto start = std::chrono::high_resolution_clock::now();
+
+				auto top = ph::top_k(stream.begin(), ph::untilValue(0), k);
+
+				auto end = std::chrono::high_resolution_clock::now();
+				//std::cout << "ph::top_k k = " << k << ": " << (end - start).count() << std::endl;
+			}
+		}
+	}
+
+	{
+		std::string log;
+		for(int i = 0; i < (1 << 20); ++i) {
+			log += "event " + std::to_string(i) + ";";
+		}
+		std::mt19937 generator(3);
+
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+
+			const auto length = ph::distance(log.c_str(), ph::LazyStrIterator{});
+			std::string picked;
+			for(int i = 0; i < 100; ++i) {
+				picked += log[std::uniform_int_distribution<std::ptrdiff_t>(0, length - 1)(generator)];
+			}
+
+			auto end = std::chrono::high_resolution_clock::now();
+			//std::cout << "ph::distance + index pick: " << (end - start).count() << std::endl;
+		}
+
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+
+			std::string picked;
+			ph::sample(log.c_str(), ph::LazyStrIterator{}, std::back_inserter(picked), 100, generator);
+
+			auto end = std::chrono::high_resolution_clock::now();
+			//std::cout << "ph::sample: " << (end - start).count() << std::endl;
+		}
+
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+
+			std::string picked;
+			ph::weighted_sample(log.c_str(), ph::LazyStrIterator{}, std::back_inserter(picked), 100,
+					[](char c) { return c == ';' ? 0.0 : 1.0; }, generator);
+
+			auto end = std::chrono::high_resolution_clock::now();
+			//std::cout << "ph::weighted_sample: " << (end - start).count() << std::endl;
+		}
+	}
+
+	{
+		struct Payload { char bytes[56]; };
+		const int size = 1 << 20;
+		std::map<int, Payload> tree;
+		std::vector<std::pair<int, Payload>> pairs;
+		ph::flat_map<int, Payload> flat;
+		flat.reserve(size);
+		for(int i = 0; i < size; ++i) {
+			tree.insert({i * 3, Payload()});
+			pairs.push_back({i * 3, Payload()});
+			flat.insert(i * 3, Payload());
+		}
+		const int missing = -1;
+
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+
+			auto keys = ph::make_iterator_range(tree.begin(), tree.end()) | ph::adaptor::map_keys;
+			auto count = ph::count(keys.begin(), keys.end(), missing);
+
+			auto end = std::chrono::high_resolution_clock::now();
+			//std::cout << "std::map key scan " << count << ": " << (end - start).count() << std::endl;
+		}
+
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+
+			auto keys = ph::make_iterator_range(pairs.begin(), pairs.end()) | ph::adaptor::map_keys;
+			auto count = ph::count(keys.begin(), keys.end(), missing);
+
+			auto end = std::chrono::high_resolution_clock::now();
+			//std::cout << "vector of pairs key scan " << count << ": " << (end - start).count() << std::endl;
+		}
+
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+
+			auto keys = flat | ph::adaptor::map_keys;
+			auto count = ph::count(keys.begin(), keys.end(), missing);
+
+			auto end = std::chrono::high_resolution_clock::now();
+			//std::cout << "ph::flat_map key scan " << count << ": " << (end - start).count() << std::endl;
+		}
+
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+
+			auto keys = flat | ph::adaptor::map_keys;
+			auto it = ph::find(keys.begin(), ph::untilValue(3 * (size - 1)) || keys.end(), missing);
+
+			auto end = std::chrono::high_resolution_clock::now();
+			//std::cout << "ph::flat_map key find with sentinel: " << (end - start).count() << std::endl;
+		}
+	}
+
+	{
+		std::vector<int> telemetry;
+		std::mt19937 generator(5);
+		while(telemetry.size() < (1u << 24)) {
+			telemetry.insert(telemetry.end(), generator() % 2000 + 1, static_cast<int>(generator() % 100) + 1);
+		}
+		telemetry.push_back(0);
+
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+
+			long long changes = 0;
+			int previous = -1;
+			ph::for_each(telemetry.data(), ph::untilValue(0), [&changes, &previous](int value) {
+				changes += value != previous;
+				previous = value;
+			});
+
+			auto end = std::chrono::high_resolution_clock::now();
+			//std::cout << "ph::for_each per element " << changes << ": " << (end - start).count() << std::endl;
+		}
+
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+
+			long long changes = 0;
+			auto runs = ph::make_iterator_range(telemetry.data(), ph::untilValue(0)) | ph::adaptor::runs();
+			ph::for_each(runs.begin(), runs.end(), [&changes](const ph::adaptor::detail::Chunk<int*>&) { ++changes; });
+
+			auto end = std::chrono::high_resolution_clock::now();
+			//std::cout << "ph::adaptor::runs " << changes << ": " << (end - start).count() << std::endl;
+		}
+	}
+
+	{
+		std::string payload(1 << 24, 'x');
+		payload.back() = '\n';
+		std::vector<ph::Range<const char*, const char*>> fragments;
+		for(std::size_t offset = 0; offset < payload.size(); offset += 1500) {
+			const std::size_t length = std::min<std::size_t>(1500, payload.size() - offset);
+			fragments.push_back(ph::make_iterator_range(payload.data() + offset, payload.data() + offset + length));
+		}
+
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+
+			std::string message;
+			for(const auto& fragment: fragments) {
+				message.append(fragment.begin(), fragment.end());
+			}
+			auto it = ph::find(message.data(), ph::untilValue('\n') || message.data() + message.size(), ':');
+
+			auto end = std::chrono::high_resolution_clock::now();
+			//std::cout << "copy fragments + ph::find " << (it - message.data()) << ": " << (end - start).count() << std::endl;
+		}
+
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+
+			auto message = ph::adaptor::concat(fragments);
+			auto it = ph::find(message.begin(), ph::untilValue('\n') || message.end(), ':');
+
+			auto end = std::chrono::high_resolution_clock::now();
+			//std::cout << "ph::adaptor::concat + ph::find " << (it == message.end()) << ": " << (end - start).count() << std::endl;
+		}
+	}
+
+	{
+		std::string log(1 << 24, 'a');
+		for(std::size_t i = 7; i < log.size(); i += 13) {
+			log[i] = '7';
+		}
+		log.back() = '\n';
+		auto letter = [](char c) { return c < '0' || c > '9'; };
+
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+
+			std::string letters;
+			std::copy_if(log.begin(), log.end(), std::back_inserter(letters), letter);
+			auto it = ph::find(letters.data(), ph::untilValue('\n') || letters.data() + letters.size(), ':');
+
+			auto end = std::chrono::high_resolution_clock::now();
+			//std::cout << "materialise filtered + ph::find " << (it - letters.data()) << ": " << (end - start).count() << std::endl;
+		}
+
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+
+			auto line = ph::make_iterator_range(log.begin(), log.end()) |
+				ph::adaptor::filtered(letter) | ph::adaptor::take_until(ph::untilValue('\n'));
+			auto it = ph::find(line.begin(), line.end(), ':');
+
+			auto end = std::chrono::high_resolution_clock::now();
+			//std::cout << "ph::adaptor::take_until + ph::find " << (it.base() - log.begin()) << ": " << (end - start).count() << std::endl;
+		}
+	}
+
+	for(double density: {0.0001, 0.01, 0.1, 0.5, 0.9}) {
+		std::vector<std::uint64_t> mask(1 << 18);
+		std::mt19937_64 generator(6);
+		std::bernoulli_distribution selected(density);
+		for(std::size_t i = 0; i < mask.size() * 64; ++i) {
+			mask[i / 64] |= static_cast<std::uint64_t>(selected(generator)) << (i % 64);
+		}
+
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+
+			std::vector<std::size_t> indices;
+			for(std::size_t i = 0; i < mask.size() * 64; ++i) {
+				if(mask[i / 64] >> (i % 64) & 1) {
+					indices.push_back(i);
+				}
+			}
+			std::size_t sum = 0;
+			ph::for_each(indices.begin(), indices.end(), [&sum](std::size_t i) { sum += i; });
+
+			auto end = std::chrono::high_resolution_clock::now();
+			//std::cout << "index vector + ph::for_each at " << density << " " << sum << ": " << (end - start).count() << std::endl;
+		}
+
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+
+			auto bits = ph::set_bits(mask);
+			std::size_t sum = 0;
+			ph::for_each(bits.begin(), bits.end(), [&sum](std::size_t i) { sum += i; });
+
+			auto end = std::chrono::high_resolution_clock::now();
+			//std::cout << "ph::set_bits + ph::for_each at " << density << " " << sum << ": " << (end - start).count() << std::endl;
+		}
+	}
+
+}
@@ -0,0 +1,240 @@
+#ifndef DELIMITERINDEX_HPP_
+#define DELIMITERINDEX_HPP_
+
+// An index of the positions of a few declared delimiter characters in an
+// immutable char buffer, in the style of the first stage of simdjson.
+//
+// Building the index is a single vectorised pass over the buffer which
+// records, for every declared character, a bitmap of the positions holding
+// it. Afterwards sentinels obtained from the index answer ph::next, ph::find
+// and ph::count by walking the bitmaps with tzcnt and popcnt, without looking
+// at the bytes again.
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "ph.hpp"
+#include "range.hpp"
+#include "algorithm.hpp"
+
+namespace ph {
+
+class DelimiterIndex;
+
+// Compares equal to positions holding any of a set of indexed characters,
+// and to the end of the indexed buffer.
+class DelimiterSentinel {
+	const DelimiterIndex* index;
+	std::uint64_t classes;
+public:
+	DelimiterSentinel(const DelimiterIndex& index, std::uint64_t classes):
+		index(&index), classes(classes) {}
+
+	template<typename Iterator>
+	bool operator()(Iterator&& it) const;
+
+	const DelimiterIndex& getIndex() const { return *index; }
+	std::uint64_t getClasses() const { return classes; }
+};
+
+template<>
+struct IsNode<DelimiterSentinel> : std::true_type {};
+
+class DelimiterIndex {
+	static constexpr std::size_t blockSize = 64;
+
+	const char* b;
+	const char* e;
+	std::vector<char> delimiters;
+	std::vector<std::uint64_t> words; // words[block * delimiters.size() + class]
+
+	std::size_t blocks() const { return (e - b + blockSize - 1) / blockSize; }
+
+	std::uint64_t word(std::size_t block, std::uint64_t classes) const {
+		const std::uint64_t* blockWords = words.data() + block * delimiters.size();
+		std::uint64_t result = 0;
+		for(; classes; classes &= classes - 1) {
+			result |= blockWords[__builtin_ctzll(classes)];
+		}
+		return result;
+	}
+
+	void indexFullBlock(std::size_t block) {
+		std::uint64_t* blockWords = words.data() + block * delimiters.size();
+		const char* data = b + block * blockSize;
+#ifdef __SSE2__
+		__m128i bytes[4];
+		for(int i = 0; i < 4; ++i) {
+			bytes[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16 * i));
+		}
+		for(std::size_t c = 0; c < delimiters.size(); ++c) {
+			const __m128i needle = _mm_set1_epi8(delimiters[c]);
+			std::uint64_t w = 0;
+			for(int i = 0; i < 4; ++i) {
+				const std::uint64_t mask = static_cast<unsigned>(
+					_mm_movemask_epi8(_mm_cmpeq_epi8(bytes[i], needle)));
+				w |= mask << (16 * i);
+			}
+			blockWords[c] = w;
+		}
+#else
+		indexPartialBlock(block, blockSize);
+		(void)blockWords;
+		(void)data;
+#endif
+	}
+
+	void indexPartialBlock(std::size_t block, std::size_t length) {
+		std::uint64_t* blockWords = words.data() + block * delimiters.size();
+		const char* data = b + block * blockSize;
+		for(std::size_t i = 0; i < length; ++i) {
+			for(std::size_t c = 0; c < delimiters.size(); ++c) {
+				if(data[i] == delimiters[c]) {
+					blockWords[c] |= std::uint64_t(1) << i;
+				}
+			}
+		}
+	}
+
+public:
+	DelimiterIndex(const char* begin, const char* end, std::initializer_list<char> delimiters):
+		b(begin), e(end), delimiters(delimiters)
+	{
+		if(this->delimiters.size() > 64) {
+			throw std::invalid_argument("ph::DelimiterIndex: at most 64 delimiters");
+		}
+		words.resize(blocks() * this->delimiters.size());
+
+		const std::size_t fullBlocks = (e - b) / blockSize;
+		for(std::size_t block = 0; block < fullBlocks; ++block) {
+			indexFullBlock(block);
+		}
+		if(fullBlocks != blocks()) {
+			indexPartialBlock(fullBlocks, (e - b) % blockSize);
+		}
+	}
+
+	const char* begin() const { return b; }
+	const char* end() const { return e; }
+
+	// The class bit of an indexed character, 0 if it was not declared.
+	template<typename T>
+	std::uint64_t classOf(const T& c) const {
+		for(std::size_t i = 0; i < delimiters.size(); ++i) {
+			if(delimiters[i] == c) {
+				return std::uint64_t(1) << i;
+			}
+		}
+		return 0;
+	}
+
+	// The index counterpart of ph::untilValue. Every character must have
+	// been declared when building the index, otherwise std::invalid_argument
+	// is thrown.
+	template<typename... Chars>
+	DelimiterSentinel untilValue(Chars... cs) const {
+		std::uint64_t classes = 0;
+		for(char c: {static_cast<char>(cs)...}) {
+			const std::uint64_t cls = classOf(c);
+			if(!cls) {
+				throw std::invalid_argument("ph::DelimiterIndex::untilValue: character was not indexed");
+			}
+			classes |= cls;
+		}
+		return DelimiterSentinel(*this, classes);
+	}
+
+	bool test(const char* position, std::uint64_t classes) const {
+		const std::size_t offset = position - b;
+		return word(offset / blockSize, classes) >> (offset % blockSize) & 1;
+	}
+
+	// First position at or after from holding one of the classes, or end().
+	const char* next(const char* from, std::uint64_t classes) const {
+		if(from >= e) {
+			return e;
+		}
+		const std::size_t offset = from - b;
+		std::size_t block = offset / blockSize;
+		std::uint64_t w = word(block, classes) & (~std::uint64_t(0) << (offset % blockSize));
+		while(!w) {
+			if(++block == blocks()) {
+				return e;
+			}
+			w = word(block, classes);
+		}
+		return b + block * blockSize + __builtin_ctzll(w);
+	}
+
+	// Number of positions in [from, to) holding one of the classes.
+	std::ptrdiff_t count(const char* from, const char* to, std::uint64_t classes) const {
+		std::ptrdiff_t result = 0;
+		for(std::size_t offset = from - b, last = to - b; offset < last;) {
+			const std::size_t block = offset / blockSize;
+			const std::size_t low = offset % blockSize;
+			const std::size_t high = std::min<std::size_t>(std::size_t(blockSize), low + (last - offset));
+			std::uint64_t w = word(block, classes) >> low;
+			if(high - low < blockSize) {
+				w &= (std::uint64_t(1) << (high - low)) - 1;
+			}
+			result += __builtin_popcountll(w);
+			offset += high - low;
+		}
+		return result;
+	}
+};
+
+template<typename Iterator>
+bool DelimiterSentinel::operator()(Iterator&& it) const {
+	return it == index->end() || index->test(it, classes);
+}
+
+// Sentinels of the same index combine into a single bitmap query.
+inline DelimiterSentinel operator||(const DelimiterSentinel& lhs, const DelimiterSentinel& rhs) {
+	assert(&lhs.getIndex() == &rhs.getIndex());
+	return DelimiterSentinel(lhs.getIndex(), lhs.getClasses() | rhs.getClasses());
+}
+
+template<typename Begin, typename = typename std::enable_if<detail::IsCharPointer<Begin>::value>::type>
+Begin next(Begin begin, const DelimiterSentinel& end) {
+	return begin + (end.getIndex().next(begin, end.getClasses()) - begin);
+}
+
+template<typename ValueType>
+const char* find(const char* begin, const DelimiterSentinel& end, const ValueType& value) {
+	const DelimiterIndex& index = end.getIndex();
+	if(const std::uint64_t valueClass = index.classOf(value)) {
+		return index.next(begin, end.getClasses() | valueClass);
+	}
+	for(; begin != end; ++begin) {
+		if(*begin == value) {
+			return begin;
+		}
+	}
+	return begin;
+}
+
+template<typename T>
+std::ptrdiff_t count(const char* begin, const DelimiterSentinel& end, const T& value) {
+	const DelimiterIndex& index = end.getIndex();
+	const char* last = index.next(begin, end.getClasses());
+	if(const std::uint64_t valueClass = index.classOf(value)) {
+		return index.count(begin, last, valueClass);
+	}
+	return ph::count(begin, last, value);
+}
+
+} // namespace ph
+
+#endif /* DELIMITERINDEX_HPP_ */
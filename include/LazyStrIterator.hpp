@@ -1,3 +1,5 @@
+#ifndef LAZYSTRITERATOR_HPP_
+#define LAZYSTRITERATOR_HPP_
 
 #include <utility>
 
@@ -16,3 +18,4 @@ template<typename It> bool operator!=(It&& it, const LazyStrIterator& s) { retur
 
 }
 
+#endif /* LAZYSTRITERATOR_HPP_ */
@@ -0,0 +1,303 @@
+#ifndef VALUESET_HPP_
+#define VALUESET_HPP_
+
+// Membership tests for large sets of stop values, where the variadic
+// untilValue would mean a deep node tree and one compare per value.
+//
+// The representation is picked from the size and spread of the set:
+//
+//  * Bitmap: integral values spanning a small range, one bit per value.
+//  * Hash:   other integral values, in a perfect hash table built by hash
+//            and displace, so a probe is always one bucket read and one slot
+//            compare.
+//  * Sorted: everything else, a sorted array cut into cache line sized
+//            blocks; a branch free binary search over the first value of
+//            each block picks the block, which is then compared in one go.
+//
+// None of the probes branches on the data.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "ph.hpp"
+
+namespace ph {
+
+enum class ValueSetRepresentation { Auto, Bitmap, Hash, Sorted };
+
+template<typename T>
+class ValueSet {
+	static constexpr std::size_t blockSize = 64 / sizeof(T) ? 64 / sizeof(T) : 1;
+
+	struct Data {
+		ValueSetRepresentation representation;
+
+		// Bitmap
+		std::uint64_t minimum = 0;
+		std::uint64_t range = 0;
+		std::vector<std::uint64_t> bits;
+
+		// Hash
+		unsigned bucketShift = 63;
+		unsigned slotShift = 63;
+		std::vector<std::uint32_t> displacements;
+		std::vector<T> slots;
+
+		// Sorted
+		std::vector<T> sorted;
+		std::vector<T> fences;
+	};
+
+	std::shared_ptr<const Data> data;
+
+
+	static unsigned bitsFor(std::size_t n) {
+		unsigned bits = 0;
+		while((std::size_t(1) << bits) < n) {
+			++bits;
+		}
+		return bits;
+	}
+
+	static std::uint64_t bucketOf(std::uint64_t x, unsigned shift) {
+		return (x * 0x9E3779B97F4A7C15ull) >> shift >> 1;
+	}
+
+	// The splitmix64 finaliser of x and the displacement; unlike a plain
+	// multiplication it separates keys that are close to each other.
+	static std::uint64_t slotOf(std::uint64_t x, std::uint32_t displacement, unsigned shift) {
+		std::uint64_t z = x + displacement * 0x9E3779B97F4A7C15ull;
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return (z ^ (z >> 31)) >> shift >> 1;
+	}
+
+	static ValueSetRepresentation choose(const std::vector<T>& values) {
+		const std::uint64_t range = std::uint64_t(values.back()) - std::uint64_t(values.front());
+		if(range < (std::uint64_t(1) << 19) || range / 64 < values.size()) {
+			return ValueSetRepresentation::Bitmap;
+		}
+		return ValueSetRepresentation::Hash;
+	}
+
+	static void buildBitmap(Data& d, const std::vector<T>& values) {
+		d.minimum = std::uint64_t(values.front());
+		d.range = std::uint64_t(values.back()) - d.minimum + 1;
+		d.bits.assign(d.range / 64 + 1, 0);
+		for(const T& v: values) {
+			const std::uint64_t offset = std::uint64_t(v) - d.minimum;
+			d.bits[offset / 64] |= std::uint64_t(1) << (offset % 64);
+		}
+	}
+
+	static void buildHash(Data& d, const std::vector<T>& values) {
+		const unsigned slotBits = bitsFor(2 * values.size());
+		const unsigned bucketBits = bitsFor(std::max<std::size_t>(values.size() / 4, 1));
+		// Shifting by 64 is undefined, hence the extra shift by one in
+		// bucketOf and slotOf, which also lets a zero bit count work.
+		d.slotShift = 63 - slotBits;
+		d.bucketShift = 63 - bucketBits;
+
+		std::vector<std::vector<std::uint64_t>> buckets(std::size_t(1) << bucketBits);
+		for(const T& v: values) {
+			buckets[bucketOf(std::uint64_t(v), d.bucketShift)].push_back(std::uint64_t(v));
+		}
+		std::vector<std::size_t> order(buckets.size());
+		for(std::size_t i = 0; i < order.size(); ++i) {
+			order[i] = i;
+		}
+		std::sort(order.begin(), order.end(), [&buckets](std::size_t a, std::size_t b) {
+			return buckets[a].size() > buckets[b].size();
+		});
+
+		std::vector<bool> taken(std::size_t(1) << slotBits);
+		d.displacements.assign(buckets.size(), 0);
+		d.slots.assign(taken.size(), values.front());
+		std::vector<std::uint64_t> candidate;
+		for(std::size_t bucket: order) {
+			for(std::uint32_t displacement = 0;; ++displacement) {
+				candidate.clear();
+				for(std::uint64_t x: buckets[bucket]) {
+					candidate.push_back(slotOf(x, displacement, d.slotShift));
+				}
+				std::sort(candidate.begin(), candidate.end());
+				const bool fits = std::adjacent_find(candidate.begin(), candidate.end()) == candidate.end() &&
+					std::none_of(candidate.begin(), candidate.end(), [&taken](std::uint64_t s) { return taken[s]; });
+				if(fits) {
+					d.displacements[bucket] = displacement;
+					for(std::uint64_t x: buckets[bucket]) {
+						const std::uint64_t s = slotOf(x, displacement, d.slotShift);
+						taken[s] = true;
+						d.slots[s] = T(x);
+					}
+					break;
+				}
+			}
+		}
+	}
+
+	static void buildSorted(Data& d, const std::vector<T>& values) {
+		d.sorted = values;
+		d.sorted.resize((values.size() + blockSize - 1) / blockSize * blockSize, values.back());
+		for(std::size_t i = 0; i < d.sorted.size(); i += blockSize) {
+			d.fences.push_back(d.sorted[i]);
+		}
+	}
+
+	bool containsBitmap(const T& v) const {
+		const std::uint64_t offset = std::uint64_t(v) - data->minimum;
+		const bool inRange = offset < data->range;
+		const std::uint64_t index = inRange ? offset : 0;
+		return inRange & (data->bits[index / 64] >> (index % 64));
+	}
+
+	bool containsHash(const T& v) const {
+		const std::uint64_t x = std::uint64_t(v);
+		const std::uint32_t displacement = data->displacements[bucketOf(x, data->bucketShift)];
+		return data->slots[slotOf(x, displacement, data->slotShift)] == v;
+	}
+
+	static bool blockContains(const T* block, const T& v, std::false_type) {
+		bool found = false;
+		for(std::size_t i = 0; i < blockSize; ++i) {
+			found |= block[i] == v;
+		}
+		return found;
+	}
+
+	static bool blockContains(const T* block, const T& v, std::true_type) {
+#ifdef __SSE2__
+		const __m128i needle = _mm_set1_epi32(static_cast<int>(v));
+		__m128i hits = _mm_setzero_si128();
+		for(std::size_t i = 0; i < blockSize; i += 4) {
+			const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i));
+			hits = _mm_or_si128(hits, _mm_cmpeq_epi32(values, needle));
+		}
+		return _mm_movemask_epi8(hits) != 0;
+#else
+		return blockContains(block, v, std::false_type{});
+#endif
+	}
+
+	bool containsSorted(const T& v) const {
+		if(data->fences.empty()) {
+			return false;
+		}
+		const T* base = data->fences.data();
+		for(std::size_t length = data->fences.size(); length > 1;) {
+			const std::size_t half = length / 2;
+			base = v < base[half] ? base : base + half;
+			length -= half;
+		}
+		const T* block = data->sorted.data() + (base - data->fences.data()) * blockSize;
+		return blockContains(block, v, std::integral_constant<bool,
+			std::is_integral<T>::value && sizeof(T) == 4>{});
+	}
+
+	void build(std::vector<T> values, ValueSetRepresentation representation) {
+		std::sort(values.begin(), values.end());
+		values.erase(std::unique(values.begin(), values.end()), values.end());
+
+		std::shared_ptr<Data> d = std::make_shared<Data>();
+		if(values.empty()) {
+			d->representation = ValueSetRepresentation::Bitmap;
+			d->range = 0;
+			d->bits.assign(1, 0);
+		} else {
+			build(*d, values, representation, std::is_integral<T>{});
+		}
+		data = d;
+	}
+
+	static void build(Data& d, const std::vector<T>& values, ValueSetRepresentation representation, std::true_type) {
+		if(representation == ValueSetRepresentation::Auto) {
+			representation = choose(values);
+		}
+		d.representation = representation;
+		switch(representation) {
+		case ValueSetRepresentation::Bitmap: buildBitmap(d, values); break;
+		case ValueSetRepresentation::Hash: buildHash(d, values); break;
+		default: buildSorted(d, values); break;
+		}
+	}
+
+	static void build(Data& d, const std::vector<T>& values, ValueSetRepresentation, std::false_type) {
+		d.representation = ValueSetRepresentation::Sorted;
+		buildSorted(d, values);
+	}
+
+	bool contains(const T& v, std::true_type) const {
+		switch(data->representation) {
+		case ValueSetRepresentation::Bitmap: return containsBitmap(v);
+		case ValueSetRepresentation::Hash: return containsHash(v);
+		default: return containsSorted(v);
+		}
+	}
+
+	bool contains(const T& v, std::false_type) const {
+		return containsSorted(v);
+	}
+
+public:
+	// Bitmap and Hash can only be used for integral types; requesting them
+	// for other types gives Sorted.
+	template<typename Iterator>
+	ValueSet(Iterator begin, Iterator end, ValueSetRepresentation representation = ValueSetRepresentation::Auto) {
+		build(std::vector<T>(begin, end), representation);
+	}
+
+	ValueSet(): ValueSet(std::initializer_list<T>{}) {}
+
+	ValueSet(std::initializer_list<T> values, ValueSetRepresentation representation = ValueSetRepresentation::Auto):
+		ValueSet(values.begin(), values.end(), representation) {}
+
+	bool contains(const T& v) const {
+		return contains(v, std::is_integral<T>{});
+	}
+
+	ValueSetRepresentation representation() const { return data->representation; }
+
+};
+
+// Stops at any value of a ValueSet. Copies share the set.
+template<typename T>
+struct AnyOfNode {
+
+	AnyOfNode(const ValueSet<T>& values) : values(values) {}
+
+	template<typename Iterator>
+	bool operator()(Iterator&& it) const {
+		return values.contains(*it);
+	}
+
+	ValueSet<T> values;
+};
+
+template<typename T>
+struct IsNode<AnyOfNode<T>> : std::true_type {};
+
+template<typename Container>
+AnyOfNode<typename std::decay<decltype(*std::begin(std::declval<const Container&>()))>::type>
+untilAnyOf(const Container& values, ValueSetRepresentation representation = ValueSetRepresentation::Auto) {
+	using T = typename std::decay<decltype(*std::begin(values))>::type;
+	return AnyOfNode<T>(ValueSet<T>(std::begin(values), std::end(values), representation));
+}
+
+template<typename T, T... Values>
+AnyOfNode<T> untilAnyOf() {
+	return AnyOfNode<T>(ValueSet<T>({Values...}));
+}
+
+} // namespace ph
+
+#endif /* VALUESET_HPP_ */
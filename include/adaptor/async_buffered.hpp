@@ -0,0 +1,249 @@
+#ifndef ADAPTOR_ASYNC_BUFFERED_HPP_
+#define ADAPTOR_ASYNC_BUFFERED_HPP_
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "ph.hpp"
+#include "range.hpp"
+
+namespace ph { namespace adaptor {
+
+namespace detail {
+
+// A single producer, single consumer ring buffer, with the upstream range
+// as its producer. Both sides only publish their position every batch
+// elements, or when they would otherwise have to wait, so the atomics are
+// touched once per batch rather than once per element. While the consumer
+// waits, the producer publishes every element as soon as it has it, so a
+// slow upstream does not hold elements back until a batch is full.
+template<typename T>
+class AsyncBuffer {
+	std::vector<T> slots;
+	const std::size_t mask;
+	const std::size_t batch;
+
+	char padding0[64];
+	std::atomic<std::size_t> published{0};
+	std::atomic<bool> finished{false};
+	char padding1[64];
+	std::atomic<std::size_t> released{0};
+	std::atomic<bool> waiting{false};
+	std::atomic<bool> cancelled{false};
+	char padding2[64];
+
+	// Consumer side state, only touched by the consuming thread.
+	std::size_t head = 0;
+	std::size_t available = 0;
+	bool done = false;
+
+	std::thread producer;
+
+	static std::size_t roundUp(std::size_t capacity) {
+		std::size_t result = 1;
+		while(result < capacity) {
+			result *= 2;
+		}
+		return result;
+	}
+
+	template<typename Begin, typename End>
+	void produce(Begin b, End e) {
+		const std::size_t capacity = slots.size();
+		std::size_t tail = 0;
+		std::size_t limit = capacity;
+
+		// Upstream iterators of other ph adaptors compare with their ends
+		// through the node operators, which ADL does not find from here.
+		using ph::operator!=;
+
+		auto stop = ph::anchor(b, e);
+		for(; b != stop; ++b) {
+			while(tail == limit) {
+				published.store(tail, std::memory_order_release);
+				limit = released.load(std::memory_order_acquire) + capacity;
+				if(tail == limit) {
+					if(cancelled.load(std::memory_order_relaxed)) {
+						return;
+					}
+					std::this_thread::yield();
+				}
+			}
+			slots[tail & mask] = *b;
+			if(++tail % batch == 0 || waiting.load(std::memory_order_relaxed)) {
+				published.store(tail, std::memory_order_release);
+			}
+			if(cancelled.load(std::memory_order_relaxed)) {
+				return;
+			}
+		}
+		published.store(tail, std::memory_order_release);
+		finished.store(true, std::memory_order_release);
+	}
+
+	void fetch() {
+		released.store(head, std::memory_order_release);
+		for(bool told = false;; told = true) {
+			const bool producerFinished = finished.load(std::memory_order_acquire);
+			available = published.load(std::memory_order_acquire);
+			if(available != head || producerFinished) {
+				if(told) {
+					waiting.store(false, std::memory_order_relaxed);
+				}
+				done = available == head;
+				return;
+			}
+			if(!told) {
+				waiting.store(true, std::memory_order_relaxed);
+			}
+			std::this_thread::yield();
+		}
+	}
+
+public:
+	AsyncBuffer(std::size_t capacity, std::size_t batch):
+		slots(roundUp(capacity)),
+		mask(slots.size() - 1),
+		batch(batch < slots.size() ? (batch ? batch : 1) : slots.size())
+	{}
+
+	AsyncBuffer(const AsyncBuffer&) = delete;
+	AsyncBuffer& operator=(const AsyncBuffer&) = delete;
+
+	~AsyncBuffer() {
+		cancelled.store(true, std::memory_order_relaxed);
+		if(producer.joinable()) {
+			producer.join();
+		}
+	}
+
+	template<typename Begin, typename End>
+	void start(Begin b, End e) {
+		producer = std::thread([this, b, e]() { produce(b, e); });
+		fetch();
+	}
+
+	bool isDone() const { return done; }
+
+	T& front() { return slots[head & mask]; }
+
+	void pop() {
+		if(++head % batch == 0) {
+			released.store(head, std::memory_order_release);
+		}
+		if(head == available) {
+			fetch();
+		}
+	}
+};
+
+struct AsyncEnd {};
+
+// Single pass, all copies share the position of the buffer.
+template<typename T>
+class AsyncBegin {
+	AsyncBuffer<T>* buffer;
+public:
+	using value_type = T;
+	using difference_type = std::ptrdiff_t;
+	using reference = T&;
+	using pointer = T*;
+	using iterator_category = std::input_iterator_tag;
+
+	AsyncBegin(): buffer(nullptr) {}
+	explicit AsyncBegin(AsyncBuffer<T>& buffer): buffer(&buffer) {}
+
+	AsyncBegin& operator++() {
+		buffer->pop();
+		return *this;
+	}
+
+	T& operator*() const { return buffer->front(); }
+	T* operator->() const { return &buffer->front(); }
+
+	bool done() const { return buffer->isDone(); }
+
+	friend bool operator==(const AsyncBegin& lhs, const AsyncBegin& rhs) { return lhs.buffer == rhs.buffer; }
+	friend bool operator!=(const AsyncBegin& lhs, const AsyncBegin& rhs) { return lhs.buffer != rhs.buffer; }
+};
+
+template<typename T>
+bool operator==(const AsyncBegin<T>& it, AsyncEnd) { return it.done(); }
+
+template<typename T>
+bool operator==(AsyncEnd, const AsyncBegin<T>& it) { return it.done(); }
+
+template<typename T>
+bool operator!=(const AsyncBegin<T>& it, AsyncEnd) { return !it.done(); }
+
+template<typename T>
+bool operator!=(AsyncEnd, const AsyncBegin<T>& it) { return !it.done(); }
+
+struct dummy_async_buffered_range {
+	std::size_t capacity;
+	std::size_t batch;
+};
+
+} // namespace detail
+
+// Runs the upstream part of a pipeline on its own thread, handing copies of
+// its elements over through a ring buffer. The upstream range ending, by
+// reaching its end or by one of its sentinels firing, ends this range.
+//
+// The range owns the thread and is therefore move only; it stops and joins
+// the producer when destroyed. The producer checks for that between upstream
+// elements, so an upstream that never produces another element nor ends,
+// like a filter over an endless generator that never matches again, keeps
+// the destructor waiting. An element finished just when the consumer starts
+// to wait may only be handed over with the next one.
+template<typename Begin, typename End>
+class AsyncBufferedRange {
+	using value_type = typename std::decay<decltype(*std::declval<Begin&>())>::type;
+
+	Begin b;
+	End e;
+	std::unique_ptr<detail::AsyncBuffer<value_type>> buffer;
+	bool started = false;
+public:
+
+	AsyncBufferedRange(const Begin& b, const End& e, std::size_t capacity, std::size_t batch):
+		b(b), e(e),
+		buffer(new detail::AsyncBuffer<value_type>(capacity, batch))
+	{}
+
+	// The first call starts the upstream thread.
+	detail::AsyncBegin<value_type> begin() {
+		if(!started) {
+			buffer->start(b, e);
+			started = true;
+		}
+		return detail::AsyncBegin<value_type>(*buffer);
+	}
+
+	detail::AsyncEnd end() const {
+		return {};
+	}
+
+};
+
+inline detail::dummy_async_buffered_range async_buffered(std::size_t capacity, std::size_t batch = 64) {
+	return detail::dummy_async_buffered_range{capacity, batch};
+}
+
+} // namespace ph::adaptor
+
+template<typename Range>
+auto operator|(Range&& r, ph::adaptor::detail::dummy_async_buffered_range ar) {
+	return ph::adaptor::AsyncBufferedRange<
+		typename std::decay<decltype(r.begin())>::type,
+		typename std::decay<decltype(r.end())>::type>(
+				r.begin(), r.end(), ar.capacity, ar.batch);
+}
+
+} // namespace ph
+
+#endif /* ADAPTOR_ASYNC_BUFFERED_HPP_ */
@@ -0,0 +1,162 @@
+#ifndef ADAPTOR_CHUNK_BY_HPP_
+#define ADAPTOR_CHUNK_BY_HPP_
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include "ph.hpp"
+#include "range.hpp"
+#include "algorithm.hpp"
+
+namespace ph { namespace adaptor {
+
+namespace detail {
+
+struct ChunkByEnd {};
+
+// A chunk of the input, with its first element and its length at hand for
+// run-length processing.
+template<typename Begin>
+class Chunk: public Range<Begin, Begin> {
+	using Base = Range<Begin, Begin>;
+public:
+	Chunk(const Begin& begin, const Begin& end): Base(begin, end) {}
+
+	decltype(auto) front() const { return *Base::begin(); }
+	std::ptrdiff_t size() const { return std::distance(Base::begin(), Base::end()); }
+};
+
+// Walks the maximal chunks of [b, e) in which every element and its
+// successor satisfy p. A chunk ends before the first pair that does not,
+// found by the adjacent_find kernel on the negated predicate, so runs of
+// equal arithmetic values behind pointers are delimited with vector compares.
+template<typename Begin, typename End, typename BinaryPredicate>
+class ChunkByBegin {
+	using AnchoredEnd = typename ph::detail::Anchor<Begin, End>::type;
+
+	Begin chunkBegin;
+	Begin chunkEnd;
+	AnchoredEnd e;
+	BinaryPredicate p;
+	bool done = false;
+
+	void scan() {
+		if(!(chunkBegin != e)) {
+			done = true;
+			return;
+		}
+		using Boundary = ph::detail::Not<BinaryPredicate>;
+		chunkEnd = ph::detail::adjacent_find(chunkBegin, e, Boundary{p}, std::integral_constant<bool,
+			ph::detail::IsArithmeticPointer<Begin>::value && ph::detail::IsVectorComparison<Boundary>::value>{});
+		if(chunkEnd != e) {
+			++chunkEnd;
+		}
+	}
+
+public:
+	using value_type = Chunk<Begin>;
+	using difference_type = std::ptrdiff_t;
+	using reference = value_type;
+	using pointer = void;
+	using iterator_category = std::forward_iterator_tag;
+
+	ChunkByBegin(Begin b, End e, BinaryPredicate p):
+		chunkBegin(b), chunkEnd(b), e(ph::anchor(b, e)), p(p)
+	{
+		scan();
+	}
+
+	ChunkByBegin& operator++() {
+		chunkBegin = chunkEnd;
+		scan();
+		return *this;
+	}
+
+	value_type operator*() const {
+		return value_type(chunkBegin, chunkEnd);
+	}
+
+	bool isDone() const { return done; }
+
+	friend bool operator==(const ChunkByBegin& lhs, const ChunkByBegin& rhs) {
+		return lhs.done == rhs.done && lhs.chunkBegin == rhs.chunkBegin;
+	}
+	friend bool operator!=(const ChunkByBegin& lhs, const ChunkByBegin& rhs) { return !(lhs == rhs); }
+
+};
+
+template<typename Begin, typename End, typename BinaryPredicate>
+bool operator==(const ChunkByBegin<Begin, End, BinaryPredicate>& it, ChunkByEnd) { return it.isDone(); }
+
+template<typename Begin, typename End, typename BinaryPredicate>
+bool operator==(ChunkByEnd, const ChunkByBegin<Begin, End, BinaryPredicate>& it) { return it.isDone(); }
+
+template<typename Begin, typename End, typename BinaryPredicate>
+bool operator!=(const ChunkByBegin<Begin, End, BinaryPredicate>& it, ChunkByEnd) { return !it.isDone(); }
+
+template<typename Begin, typename End, typename BinaryPredicate>
+bool operator!=(ChunkByEnd, const ChunkByBegin<Begin, End, BinaryPredicate>& it) { return !it.isDone(); }
+
+template<typename BinaryPredicate>
+struct dummy_chunk_by_range { BinaryPredicate predicate; };
+
+} // namespace detail
+
+
+template<typename Begin, typename End, typename BinaryPredicate>
+class ChunkByRange: public Range<Begin, End> {
+	using Base = Range<Begin, End>;
+	BinaryPredicate predicate;
+public:
+
+	ChunkByRange(const Begin& begin, const End& end, BinaryPredicate predicate):
+		Base(begin, end),
+		predicate(predicate)
+	{}
+
+	auto begin() const {
+		return detail::ChunkByBegin<Begin, End, BinaryPredicate>(
+			Base::begin(),
+			Base::end(),
+			predicate);
+	}
+
+	detail::ChunkByEnd end() const {
+		return {};
+	}
+
+};
+
+// Splits a range into its maximal chunks of neighbours satisfying p, like
+// std::views::chunk_by:
+//
+//   auto ascending = ph::make_iterator_range(v.begin(), ph::untilValue(0)) |
+//       ph::adaptor::chunk_by(std::less<int>());
+template<typename BinaryPredicate>
+auto chunk_by(BinaryPredicate p) {
+	return detail::dummy_chunk_by_range<BinaryPredicate>{p};
+}
+
+// Splits a range into runs of equal elements; every run tells its value and
+// its length:
+//
+//   for_each(runs.begin(), runs.end(), [](const auto& run) {
+//       process(run.front(), run.size());
+//   });
+inline auto runs() {
+	return chunk_by(std::equal_to<>());
+}
+
+} // namespace ph::adaptor
+
+template<typename Range, typename BinaryPredicate>
+auto operator|(Range&& r, ph::adaptor::detail::dummy_chunk_by_range<BinaryPredicate> cr) {
+	return ph::adaptor::ChunkByRange<
+		typename std::decay<decltype(r.begin())>::type,
+		typename std::decay<decltype(r.end())>::type, BinaryPredicate>(
+				r.begin(), r.end(), cr.predicate);
+}
+
+} // namespace ph
+
+#endif /* ADAPTOR_CHUNK_BY_HPP_ */
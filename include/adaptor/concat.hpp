@@ -0,0 +1,357 @@
+#ifndef ADAPTOR_CONCAT_HPP_
+#define ADAPTOR_CONCAT_HPP_
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include "ph.hpp"
+#include "range.hpp"
+#include "algorithm.hpp"
+
+namespace ph { namespace adaptor {
+
+namespace detail {
+
+struct ConcatEnd {};
+
+// Walks the elements of a sequence of segments, each a range of its own,
+// skipping empty segments. Segment is an iterator over the segments.
+template<typename Segment>
+class ConcatBegin {
+	using Inner = typename std::decay<decltype((*std::declval<Segment>()).begin())>::type;
+	using InnerEnd = typename ph::detail::Anchor<Inner,
+		typename std::decay<decltype((*std::declval<Segment>()).end())>::type>::type;
+
+	Segment segment;
+	Segment last;
+	Inner pos;
+	InnerEnd e;
+
+	void skipEmpty() {
+		for(; segment != last; ++segment) {
+			pos = (*segment).begin();
+			e = ph::anchor(pos, (*segment).end());
+			if(pos != e) {
+				return;
+			}
+		}
+	}
+
+public:
+	using value_type = typename std::iterator_traits<Inner>::value_type;
+	using difference_type = std::ptrdiff_t;
+	using reference = typename std::iterator_traits<Inner>::reference;
+	using pointer = typename std::iterator_traits<Inner>::pointer;
+	using iterator_category = std::forward_iterator_tag;
+
+	ConcatBegin(Segment first, Segment last): segment(first), last(last), pos(), e() {
+		skipEmpty();
+	}
+
+	ConcatBegin& operator++() {
+		if(!(++pos != e)) {
+			nextSegment();
+		}
+		return *this;
+	}
+
+	reference operator*() const { return *pos; }
+
+	bool isDone() const { return !(segment != last); }
+
+	bool operator==(const ConcatBegin& other) const {
+		return segment == other.segment && (isDone() || pos == other.pos);
+	}
+
+	bool operator!=(const ConcatBegin& other) const { return !(*this == other); }
+
+	// The position within the current segment and the end of that segment,
+	// for algorithms that run their loops a segment at a time.
+	const Inner& position() const { return pos; }
+	const InnerEnd& segmentEnd() const { return e; }
+
+	// Moves to it, which has to be before the end of the current segment.
+	void moveTo(const Inner& it) { pos = it; }
+
+	void nextSegment() {
+		++segment;
+		skipEmpty();
+	}
+
+};
+
+template<typename Segment>
+bool operator==(const ConcatBegin<Segment>& it, ConcatEnd) { return it.isDone(); }
+
+template<typename Segment>
+bool operator==(ConcatEnd, const ConcatBegin<Segment>& it) { return it.isDone(); }
+
+template<typename Segment>
+bool operator!=(const ConcatBegin<Segment>& it, ConcatEnd) { return !it.isDone(); }
+
+template<typename Segment>
+bool operator!=(ConcatEnd, const ConcatBegin<Segment>& it) { return !it.isDone(); }
+
+// Stop conditions that only look at the element, and so can be evaluated on
+// the iterators of a segment as well.
+template<typename Node, typename = void>
+struct IsLocal : std::false_type {};
+
+template<typename T>
+struct IsLocal<ValueNode<T>> : std::true_type {};
+
+template<typename Constraint>
+struct IsLocal<LeafNode<Constraint>, decltype(void(&std::decay<Constraint>::type::operator()))> : std::true_type {};
+
+template<typename LeftNode, typename RightNode>
+struct IsLocal<OrNode<LeftNode, RightNode>> :
+	std::integral_constant<bool, IsLocal<LeftNode>::value && IsLocal<RightNode>::value> {};
+
+template<typename LeftNode, typename RightNode>
+struct IsLocal<AndNode<LeftNode, RightNode>> :
+	std::integral_constant<bool, IsLocal<LeftNode>::value && IsLocal<RightNode>::value> {};
+
+template<typename OperandNode>
+struct IsLocal<NotNode<OperandNode>> : IsLocal<OperandNode> {};
+
+// The end of the piece of the current segment that a scan for an end of the
+// concat range covers: the end of the segment, or-ed with the local part of
+// the end, which fires before it. The end of the segment comes first, so
+// that the local part is never evaluated past the segment. Other ends have
+// no SegmentEnd, and take the generic paths.
+template<typename End, typename = void>
+struct SegmentEnd : std::false_type {};
+
+template<>
+struct SegmentEnd<ConcatEnd> : std::true_type {
+	using StopsEarly = std::false_type;
+
+	template<typename InnerEnd>
+	static const InnerEnd& piece(const InnerEnd& segmentEnd, const ConcatEnd&) {
+		return segmentEnd;
+	}
+};
+
+template<typename Local>
+struct SegmentEnd<OrNode<Local, LeafNode<ConcatEnd>>, typename std::enable_if<IsLocal<Local>::value>::type> : std::true_type {
+	using StopsEarly = std::true_type;
+
+	template<typename InnerEnd>
+	static auto piece(const InnerEnd& segmentEnd, const OrNode<Local, LeafNode<ConcatEnd>>& end) {
+		return segmentEnd || end.leftNode;
+	}
+};
+
+template<typename Local>
+struct SegmentEnd<OrNode<LeafNode<ConcatEnd>, Local>, typename std::enable_if<IsLocal<Local>::value>::type> : std::true_type {
+	using StopsEarly = std::true_type;
+
+	template<typename InnerEnd>
+	static auto piece(const InnerEnd& segmentEnd, const OrNode<LeafNode<ConcatEnd>, Local>& end) {
+		return segmentEnd || end.rightNode;
+	}
+};
+
+// Returned by bodies that always run to the end of the piece, when the piece
+// is the whole segment.
+struct WholeSegment {};
+
+template<typename Segment, typename Inner>
+bool stopsInside(ConcatBegin<Segment>& begin, const Inner& it) {
+	if(it != begin.segmentEnd()) {
+		begin.moveTo(it);
+		return true;
+	}
+	return false;
+}
+
+template<typename Segment>
+bool stopsInside(ConcatBegin<Segment>&, WholeSegment) {
+	return false;
+}
+
+// Hands body the contiguous pieces of [begin, end), one per segment, each as
+// a segment iterator and the end of the piece. body scans its piece once and
+// returns where it stopped; the walk ends there unless that is the end of
+// the segment.
+template<typename Segment, typename End, typename Body>
+ConcatBegin<Segment> walk(ConcatBegin<Segment> begin, const End& end, Body body) {
+	for(; !begin.isDone(); begin.nextSegment()) {
+		if(stopsInside(begin, body(begin.position(), SegmentEnd<End>::piece(begin.segmentEnd(), end)))) {
+			return begin;
+		}
+	}
+	return begin;
+}
+
+// Counting has to tell where it stopped when the piece may end before its
+// segment does; it then hops from match to match with find, otherwise it
+// counts the whole segment with count.
+template<typename Inner, typename Stop, typename T>
+WholeSegment countPiece(Inner it, const Stop& stop, const T& value, std::ptrdiff_t& ret, std::false_type) {
+	ret += ph::count(it, stop, value);
+	return {};
+}
+
+template<typename Inner, typename Stop, typename T>
+Inner countPiece(Inner it, const Stop& stop, const T& value, std::ptrdiff_t& ret, std::true_type) {
+	for(; (it = ph::find(it, stop, value)) != stop; ++it) {
+		++ret;
+	}
+	return it;
+}
+
+template<typename Inner, typename Stop, typename UnaryPredicate>
+WholeSegment countPieceIf(Inner it, const Stop& stop, UnaryPredicate& p, std::ptrdiff_t& ret, std::false_type) {
+	ret += ph::count_if(it, stop, p);
+	return {};
+}
+
+template<typename Inner, typename Stop, typename UnaryPredicate>
+Inner countPieceIf(Inner it, const Stop& stop, UnaryPredicate& p, std::ptrdiff_t& ret, std::true_type) {
+	for(; (it = ph::find_if(it, stop, p)) != stop; ++it) {
+		++ret;
+	}
+	return it;
+}
+
+template<typename Segment>
+class ConcatRange {
+	Segment first;
+	Segment last;
+public:
+
+	ConcatRange(Segment first, Segment last): first(first), last(last) {}
+
+	ConcatBegin<Segment> begin() const { return ConcatBegin<Segment>(first, last); }
+	ConcatEnd end() const { return {}; }
+
+};
+
+// Walks segments that the iterators own together, so that adaptors storing
+// iterators of a temporary concat range do not outlive its segments.
+template<typename Range, std::size_t N>
+class SharedSegment {
+	std::shared_ptr<const std::array<Range, N>> segments;
+	const Range* segment;
+public:
+
+	SharedSegment(): segment(nullptr) {}
+	SharedSegment(std::shared_ptr<const std::array<Range, N>> segments, std::size_t i):
+		segments(std::move(segments)), segment(this->segments->data() + i) {}
+
+	const Range& operator*() const { return *segment; }
+
+	SharedSegment& operator++() {
+		++segment;
+		return *this;
+	}
+
+	bool operator==(const SharedSegment& other) const { return segment == other.segment; }
+	bool operator!=(const SharedSegment& other) const { return segment != other.segment; }
+};
+
+template<typename Range, std::size_t N>
+class ConcatArray {
+	std::shared_ptr<const std::array<Range, N>> segments;
+public:
+
+	explicit ConcatArray(const std::array<Range, N>& segments):
+		segments(std::make_shared<const std::array<Range, N>>(segments)) {}
+
+	ConcatBegin<SharedSegment<Range, N>> begin() const {
+		return ConcatBegin<SharedSegment<Range, N>>(SharedSegment<Range, N>(segments, 0), SharedSegment<Range, N>(segments, N));
+	}
+	ConcatEnd end() const { return {}; }
+
+};
+
+} // namespace detail
+
+// Joins segments into one range without copying them, e.g. the fragments of
+// a message:
+//
+//   std::vector<ph::Range<const char*, const char*>> fragments = ...;
+//   auto message = ph::adaptor::concat(fragments);
+//   auto it = ph::find(message.begin(), ph::untilValue('\n') || message.end(), ':');
+//
+// With one argument, that argument holds the segments and has to outlive the
+// range; with more, each argument is a segment and they have to be ranges of
+// the same type, which the range and its iterators keep a shared copy of. ph::find, find_if, count, count_if, for_each and next run
+// their loops, and the vectorised kernels, a segment at a time when the end
+// is the end of the concat range, optionally or-ed with conditions on the
+// elements like untilValue.
+template<typename Segments>
+auto concat(const Segments& segments) {
+	return detail::ConcatRange<decltype(std::begin(segments))>(std::begin(segments), std::end(segments));
+}
+
+template<typename Range, typename... Ranges>
+auto concat(const Range& first, const Range& second, const Ranges&... rest) {
+	using Segments = std::array<Range, 2 + sizeof...(Ranges)>;
+	return detail::ConcatArray<Range, 2 + sizeof...(Ranges)>(Segments{{first, second, rest...}});
+}
+
+} // namespace ph::adaptor
+
+template<typename Segment, typename End, typename ValueType>
+typename std::enable_if<adaptor::detail::SegmentEnd<End>::value, adaptor::detail::ConcatBegin<Segment>>::type
+find(adaptor::detail::ConcatBegin<Segment> begin, End end, const ValueType& value) {
+	return adaptor::detail::walk(begin, end, [&value](auto it, const auto& stop) {
+		return ph::find(it, stop, value);
+	});
+}
+
+template<typename Segment, typename End, typename UnaryPredicate>
+typename std::enable_if<adaptor::detail::SegmentEnd<End>::value, adaptor::detail::ConcatBegin<Segment>>::type
+find_if(adaptor::detail::ConcatBegin<Segment> begin, End end, UnaryPredicate p) {
+	return adaptor::detail::walk(begin, end, [&p](auto it, const auto& stop) {
+		return ph::find_if(it, stop, p);
+	});
+}
+
+template<typename Segment, typename End, typename T>
+typename std::enable_if<adaptor::detail::SegmentEnd<End>::value, std::ptrdiff_t>::type
+count(adaptor::detail::ConcatBegin<Segment> begin, End end, const T& value) {
+	std::ptrdiff_t ret = 0;
+	adaptor::detail::walk(begin, end, [&ret, &value](auto it, const auto& stop) {
+		return adaptor::detail::countPiece(it, stop, value, ret, typename adaptor::detail::SegmentEnd<End>::StopsEarly{});
+	});
+	return ret;
+}
+
+template<typename Segment, typename End, typename UnaryPredicate>
+typename std::enable_if<adaptor::detail::SegmentEnd<End>::value, std::ptrdiff_t>::type
+count_if(adaptor::detail::ConcatBegin<Segment> begin, End end, UnaryPredicate p) {
+	std::ptrdiff_t ret = 0;
+	adaptor::detail::walk(begin, end, [&ret, &p](auto it, const auto& stop) {
+		return adaptor::detail::countPieceIf(it, stop, p, ret, typename adaptor::detail::SegmentEnd<End>::StopsEarly{});
+	});
+	return ret;
+}
+
+template<typename Segment, typename End, typename UnaryFunction>
+typename std::enable_if<adaptor::detail::SegmentEnd<End>::value, UnaryFunction>::type
+for_each(adaptor::detail::ConcatBegin<Segment> begin, End end, UnaryFunction f) {
+	adaptor::detail::walk(begin, end, [&f](auto it, const auto& stop) {
+		for(; it != stop; ++it) {
+			f(*it);
+		}
+		return it;
+	});
+	return f;
+}
+
+template<typename Segment, typename End>
+typename std::enable_if<adaptor::detail::SegmentEnd<End>::value, adaptor::detail::ConcatBegin<Segment>>::type
+next(adaptor::detail::ConcatBegin<Segment> begin, End end) {
+	return adaptor::detail::walk(begin, end, [](auto it, const auto& stop) {
+		return ph::next(it, stop);
+	});
+}
+
+} // namespace ph
+
+#endif /* ADAPTOR_CONCAT_HPP_ */
@@ -1,5 +1,6 @@
 #ifndef ADAPTOR_FILTERED_HPP_
 #define ADAPTOR_FILTERED_HPP_
+#include <iterator>
 #include "ph.hpp"
 #include "range.hpp"
 
@@ -13,6 +14,12 @@ class FilteredBegin {
 	End e;
 	UnaryPredicate p;
 public:
+	using value_type = typename std::iterator_traits<Begin>::value_type;
+	using difference_type = typename std::iterator_traits<Begin>::difference_type;
+	using reference = typename std::iterator_traits<Begin>::reference;
+	using pointer = typename std::iterator_traits<Begin>::pointer;
+	using iterator_category = std::forward_iterator_tag;
+
 	FilteredBegin() = default;
 	FilteredBegin(Begin b, End e, UnaryPredicate p):
 		b(b), e(e), p(p)
@@ -28,21 +35,38 @@ public:
 		return *this;
 	}
 
-	auto& operator*() {
+	decltype(auto) operator*() {
 		return *b;
 	}
 
-	const auto& operator*() const {
+	decltype(auto) operator*() const {
 		return *b;
 	}
 
-	template<typename Iterator>
-	bool operator()(Iterator&& it) const {
-		return it == b;
-	}
+	// The position in the upstream range.
+	const Begin& base() const { return b; }
+
+	// Filtered iterators of the same range are at the same element when
+	// their upstream positions are, which counted() relies on.
+	friend bool operator==(const FilteredBegin& lhs, const FilteredBegin& rhs) { return lhs.b == rhs.b; }
+	friend bool operator!=(const FilteredBegin& lhs, const FilteredBegin& rhs) { return !(lhs.b == rhs.b); }
 
 };
 
+// The filtered range ends with the upstream one. Ends that are trees, e.g.
+// from take_until, are evaluated on the filtered iterator instead.
+template<typename Begin, typename End, typename UnaryPredicate>
+bool operator==(const FilteredBegin<Begin, End, UnaryPredicate>& it, const End& e) { return it.base() == e; }
+
+template<typename Begin, typename End, typename UnaryPredicate>
+bool operator==(const End& e, const FilteredBegin<Begin, End, UnaryPredicate>& it) { return it.base() == e; }
+
+template<typename Begin, typename End, typename UnaryPredicate>
+bool operator!=(const FilteredBegin<Begin, End, UnaryPredicate>& it, const End& e) { return !(it.base() == e); }
+
+template<typename Begin, typename End, typename UnaryPredicate>
+bool operator!=(const End& e, const FilteredBegin<Begin, End, UnaryPredicate>& it) { return !(it.base() == e); }
+
 template<typename UnaryPredicate>
 struct dummy_filtered_range {UnaryPredicate predicate; };
 
@@ -84,14 +108,12 @@ auto filtered(UnaryPredicate p) {
 }
 
 } // namespace ph::adaptor
-template<typename Begin, typename End, typename UnaryPredicate>
-struct IsNode<adaptor::detail::FilteredBegin<Begin, End, UnaryPredicate>> :
-std::true_type {};
 
 template<typename Range, typename UnaryPredicate>
-auto operator|(Range r, ph::adaptor::detail::dummy_filtered_range<UnaryPredicate> fr) {
+auto operator|(Range&& r, ph::adaptor::detail::dummy_filtered_range<UnaryPredicate> fr) {
 	return ph::adaptor::FilteredRange<
-		decltype(r.begin()), decltype(r.end()), UnaryPredicate>(
+		typename std::decay<decltype(r.begin())>::type,
+		typename std::decay<decltype(r.end())>::type, UnaryPredicate>(
 				r.begin(), r.end(), fr.predicate);
 }
 
@@ -57,8 +57,8 @@ public:
 
 template<typename Begin, typename End>
 class Map_Values {
-	detail::map_key_iterator<Begin> b;
-	detail::map_key_iterator<End> e;
+	detail::map_value_iterator<Begin> b;
+	detail::map_value_iterator<End> e;
 
 public:
 
@@ -67,11 +67,11 @@ public:
 		b(detail::map_value_iterator<Begin>{_b}),
 		e(detail::map_value_iterator<End>{_e}) {}
 
-	detail::map_key_iterator<Begin>& begin() { return b; }
-	const detail::map_key_iterator<Begin>& begin() const { return b; }
+	detail::map_value_iterator<Begin>& begin() { return b; }
+	const detail::map_value_iterator<Begin>& begin() const { return b; }
 
-	detail::map_key_iterator<End>& end() { return e; }
-	const detail::map_key_iterator<End>& end() const { return e; }
+	detail::map_value_iterator<End>& end() { return e; }
+	const detail::map_value_iterator<End>& end() const { return e; }
 
 };
 
@@ -95,7 +95,7 @@ auto operator|(Range r, ph::adaptor::detail::dummy_map_keys_range) {
 
 template<typename Range>
 auto operator|(Range r, ph::adaptor::detail::dummy_map_values_range) {
-	return ph::adaptor::Map_Keys<decltype(r.begin()), decltype(r.end())>{r.begin(), r.end()};
+	return ph::adaptor::Map_Values<decltype(r.begin()), decltype(r.end())>{r.begin(), r.end()};
 }
 
 
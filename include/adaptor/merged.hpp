@@ -0,0 +1,179 @@
+#ifndef ADAPTOR_MERGED_HPP_
+#define ADAPTOR_MERGED_HPP_
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "ph.hpp"
+#include "range.hpp"
+
+namespace ph { namespace adaptor {
+
+namespace detail {
+
+// Number of leaves of the tournament, the next power of two.
+constexpr std::size_t leavesFor(std::size_t n) {
+	return n <= 1 ? 1 : 2 * leavesFor((n + 1) / 2);
+}
+
+struct MergedEnd {};
+
+template<typename T, typename Begins, typename Ends, typename Indices>
+class MergedBegin;
+
+// A loser tree over the current heads of the ranges. The heads are copied
+// into one array, so that the matches compare values of a single type and
+// the tree needs no access to the differently typed iterators; tree[0] is
+// the overall winner and every inner node i holds the loser of its match,
+// with the children of i at 2i and 2i + 1 and leaf j at M + j. Taking an
+// element replays only the matches on the path from its leaf to the root.
+template<typename T, typename... Begins, typename... Ends, std::size_t... Is>
+class MergedBegin<T, std::tuple<Begins...>, std::tuple<Ends...>, std::index_sequence<Is...>> {
+	static constexpr std::size_t M = leavesFor(sizeof...(Begins));
+
+	std::tuple<Begins...> begins;
+	std::tuple<Ends...> ends;
+	std::array<T, M> heads;
+	std::array<bool, M> exhausted;
+	std::array<std::size_t, M> tree;
+
+	template<std::size_t I>
+	void load() {
+		using ph::operator==;
+		exhausted[I] = std::get<I>(begins) == std::get<I>(ends);
+		if(!exhausted[I]) {
+			heads[I] = *std::get<I>(begins);
+		}
+	}
+
+	template<std::size_t I>
+	void advance() {
+		++std::get<I>(begins);
+		load<I>();
+	}
+
+	// Exhausted ranges lose against everything, equal heads are taken in
+	// the order of the ranges, which keeps the merge stable.
+	bool beats(std::size_t a, std::size_t b) const {
+		if(exhausted[a] != exhausted[b]) {
+			return exhausted[b];
+		}
+		if(!exhausted[a]) {
+			if(heads[a] < heads[b]) {
+				return true;
+			}
+			if(heads[b] < heads[a]) {
+				return false;
+			}
+		}
+		return a < b;
+	}
+
+	std::size_t play(std::size_t node) {
+		if(node >= M) {
+			return node - M;
+		}
+		const std::size_t left = play(2 * node);
+		const std::size_t right = play(2 * node + 1);
+		if(beats(left, right)) {
+			tree[node] = right;
+			return left;
+		}
+		tree[node] = left;
+		return right;
+	}
+
+	void replay(std::size_t leaf) {
+		std::size_t winner = leaf;
+		for(std::size_t node = (M + leaf) / 2; node; node /= 2) {
+			if(beats(tree[node], winner)) {
+				std::swap(tree[node], winner);
+			}
+		}
+		tree[0] = winner;
+	}
+
+public:
+	using value_type = T;
+	using difference_type = std::ptrdiff_t;
+	using reference = const T&;
+	using pointer = const T*;
+	using iterator_category = std::forward_iterator_tag;
+
+	MergedBegin(const std::tuple<Begins...>& begins, const std::tuple<Ends...>& ends):
+		begins(begins), ends(ends), heads(), exhausted(), tree()
+	{
+		exhausted.fill(true);
+		(void)std::initializer_list<int>{(load<Is>(), 0)...};
+		tree[0] = play(1);
+	}
+
+	MergedBegin& operator++() {
+		using Advance = void (MergedBegin::*)();
+		static const Advance advances[] = {&MergedBegin::advance<Is>...};
+		const std::size_t winner = tree[0];
+		(this->*advances[winner])();
+		replay(winner);
+		return *this;
+	}
+
+	const T& operator*() const { return heads[tree[0]]; }
+	const T* operator->() const { return &heads[tree[0]]; }
+
+	// Index of the range the current element comes from.
+	std::size_t source() const { return tree[0]; }
+
+	bool done() const { return exhausted[tree[0]]; }
+
+};
+
+template<typename T, typename Begins, typename Ends, typename Indices>
+bool operator==(const MergedBegin<T, Begins, Ends, Indices>& it, MergedEnd) { return it.done(); }
+
+template<typename T, typename Begins, typename Ends, typename Indices>
+bool operator==(MergedEnd, const MergedBegin<T, Begins, Ends, Indices>& it) { return it.done(); }
+
+template<typename T, typename Begins, typename Ends, typename Indices>
+bool operator!=(const MergedBegin<T, Begins, Ends, Indices>& it, MergedEnd) { return !it.done(); }
+
+template<typename T, typename Begins, typename Ends, typename Indices>
+bool operator!=(MergedEnd, const MergedBegin<T, Begins, Ends, Indices>& it) { return !it.done(); }
+
+} // namespace detail
+
+template<typename Begin>
+class MergedRange {
+	Begin b;
+public:
+
+	explicit MergedRange(const Begin& b): b(b) {}
+
+	const Begin& begin() const { return b; }
+	detail::MergedEnd end() const { return {}; }
+
+};
+
+// Merges sorted ranges of any iterator and sentinel types into one sorted
+// range, without measuring or copying them first:
+//
+//   auto all = ph::adaptor::merged(
+//       ph::make_iterator_range(v.begin(), ph::untilValue(-1)),
+//       ph::make_iterator_range(l.begin(), l.end()));
+//
+// Elements are compared with <, and equal elements come in the order of the
+// ranges. The merged range ends once every range reached its own end.
+template<typename... Ranges>
+auto merged(const Ranges&... rs) {
+	using T = typename std::common_type<typename std::decay<decltype(*rs.begin())>::type...>::type;
+	auto begins = std::make_tuple(rs.begin()...);
+	auto ends = std::make_tuple(ph::anchor(rs.begin(), rs.end())...);
+	using Begin = detail::MergedBegin<T, decltype(begins), decltype(ends), std::index_sequence_for<Ranges...>>;
+	return MergedRange<Begin>(Begin(begins, ends));
+}
+
+} } // namespace ph::adaptor
+
+#endif /* ADAPTOR_MERGED_HPP_ */
@@ -0,0 +1,135 @@
+#ifndef ADAPTOR_SPLIT_HPP_
+#define ADAPTOR_SPLIT_HPP_
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include "ph.hpp"
+#include "range.hpp"
+
+namespace ph { namespace adaptor {
+
+namespace detail {
+
+struct SplitEnd {};
+
+// Walks the fields of [b, e) separated by positions where the delimiter tree
+// fires. Each field is a Range over the input, so nothing is copied or
+// allocated. Like boost::split, n delimiters always give n+1 fields, some of
+// which may be empty.
+template<typename Begin, typename End, typename Delimiter>
+class SplitBegin {
+	using AnchoredEnd = typename ph::detail::Anchor<Begin, End>::type;
+
+	Begin fieldBegin;
+	Begin fieldEnd;
+	AnchoredEnd e;
+	Delimiter d;
+	bool last = false;
+	bool done = false;
+
+	// The stop is built from e for every field: e has been evaluated up to
+	// the previous field, so a counter in it only walks the new one. e comes
+	// first, so the delimiter never reads the element at the end.
+	void scan() {
+		fieldEnd = ph::next(fieldBegin, e || d);
+		last = fieldEnd == e;
+	}
+
+public:
+	using value_type = Range<Begin, Begin>;
+	using difference_type = std::ptrdiff_t;
+	using reference = value_type;
+	using pointer = void;
+	using iterator_category = std::forward_iterator_tag;
+
+	SplitBegin(Begin b, End e, Delimiter d):
+		fieldBegin(b), fieldEnd(b), e(ph::anchor(b, e)), d(d)
+	{
+		scan();
+	}
+
+	SplitBegin& operator++() {
+		if(last) {
+			done = true;
+		} else {
+			fieldBegin = ++fieldEnd;
+			scan();
+		}
+		return *this;
+	}
+
+	value_type operator*() const {
+		return value_type(fieldBegin, fieldEnd);
+	}
+
+	bool isDone() const { return done; }
+
+};
+
+template<typename Begin, typename End, typename Delimiter>
+bool operator==(const SplitBegin<Begin, End, Delimiter>& it, SplitEnd) { return it.isDone(); }
+
+template<typename Begin, typename End, typename Delimiter>
+bool operator==(SplitEnd, const SplitBegin<Begin, End, Delimiter>& it) { return it.isDone(); }
+
+template<typename Begin, typename End, typename Delimiter>
+bool operator!=(const SplitBegin<Begin, End, Delimiter>& it, SplitEnd) { return !it.isDone(); }
+
+template<typename Begin, typename End, typename Delimiter>
+bool operator!=(SplitEnd, const SplitBegin<Begin, End, Delimiter>& it) { return !it.isDone(); }
+
+template<typename Delimiter>
+struct dummy_split_range { Delimiter delimiter; };
+
+} // namespace detail
+
+
+template<typename Begin, typename End, typename Delimiter>
+class SplitRange: public Range<Begin, End> {
+	using Base = Range<Begin, End>;
+	Delimiter delimiter;
+public:
+
+	SplitRange(const Begin& begin, const End& end, Delimiter delimiter):
+		Base(begin, end),
+		delimiter(delimiter)
+	{}
+
+	auto begin() const {
+		return detail::SplitBegin<Begin, End, Delimiter>(
+			Base::begin(),
+			Base::end(),
+			delimiter);
+	}
+
+	detail::SplitEnd end() const {
+		return {};
+	}
+
+};
+
+// Splits a range of chars into fields wherever the delimiter tree fires:
+//
+//   auto fields = ph::make_iterator_range(line, ph::LazyStrIterator{}) |
+//       ph::adaptor::split(ph::untilValue(',', ';'));
+//
+// Char pointer ranges delimited by values are searched with the vectorised
+// kernels of ph::next.
+template<typename Delimiter>
+auto split(Delimiter d) {
+	return detail::dummy_split_range<Delimiter>{d};
+}
+
+} // namespace ph::adaptor
+
+template<typename Range, typename Delimiter>
+auto operator|(Range&& r, ph::adaptor::detail::dummy_split_range<Delimiter> sr) {
+	return ph::adaptor::SplitRange<
+		typename std::decay<decltype(r.begin())>::type,
+		typename std::decay<decltype(r.end())>::type, Delimiter>(
+				r.begin(), r.end(), sr.delimiter);
+}
+
+} // namespace ph
+
+#endif /* ADAPTOR_SPLIT_HPP_ */
@@ -0,0 +1,69 @@
+#ifndef ADAPTOR_UNTIL_HPP_
+#define ADAPTOR_UNTIL_HPP_
+#include <type_traits>
+#include "ph.hpp"
+#include "range.hpp"
+
+namespace ph { namespace adaptor {
+
+namespace detail {
+
+template<typename Tree>
+struct dummy_take_until_range { Tree tree; };
+
+template<typename Tree>
+struct dummy_drop_until_range { Tree tree; };
+
+} // namespace detail
+
+// Cuts a range before the first element where tree fires. The tree is or-ed
+// into the end of the range, behind its own end, so the result is a plain
+// Range whose loops keep a single exit test:
+//
+//   auto line = ph::make_iterator_range(v.begin(), v.end()) |
+//       ph::adaptor::filtered(p) | ph::adaptor::take_until(ph::untilValue('\n'));
+//
+// Trees built from values still reach the vectorised kernels of find and
+// count, and counted() budgets start at the begin of the range.
+template<typename Tree>
+auto take_until(const Tree& tree) {
+	static_assert(IsNode<Tree>::value, "take_until expects a tree like untilValue(...) or until(...)");
+	return detail::dummy_take_until_range<Tree>{tree};
+}
+
+// Starts a range at the first element where tree fires. The skipped prefix
+// is scanned once, when the range is built; the end stays as it was, with
+// any counted() budget in it still counting from the original begin.
+template<typename Tree>
+auto drop_until(const Tree& tree) {
+	static_assert(IsNode<Tree>::value, "drop_until expects a tree like untilValue(...) or until(...)");
+	return detail::dummy_drop_until_range<Tree>{tree};
+}
+
+template<typename UnaryPredicate>
+auto take_while(UnaryPredicate p) {
+	return take_until(!LeafNode<UnaryPredicate>(p));
+}
+
+template<typename UnaryPredicate>
+auto drop_while(UnaryPredicate p) {
+	return drop_until(!LeafNode<UnaryPredicate>(p));
+}
+
+} // namespace ph::adaptor
+
+template<typename Range, typename Tree>
+auto operator|(Range&& r, ph::adaptor::detail::dummy_take_until_range<Tree> tr) {
+	return make_iterator_range(r.begin(), r.end() || tr.tree);
+}
+
+template<typename Range, typename Tree>
+auto operator|(Range&& r, ph::adaptor::detail::dummy_drop_until_range<Tree> dr) {
+	auto begin = r.begin();
+	auto end = ph::anchor(begin, r.end());
+	return make_iterator_range(ph::next(begin, end || dr.tree), end);
+}
+
+} // namespace ph
+
+#endif /* ADAPTOR_UNTIL_HPP_ */
@@ -0,0 +1,96 @@
+#ifndef ADAPTOR_ZIP_HPP_
+#define ADAPTOR_ZIP_HPP_
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include "ph.hpp"
+#include "range.hpp"
+
+namespace ph { namespace adaptor {
+
+namespace detail {
+
+template<typename End1, typename End2>
+struct ZipEnd {
+	End1 end1;
+	End2 end2;
+};
+
+template<typename Begin1, typename Begin2>
+class ZipBegin {
+	Begin1 b1;
+	Begin2 b2;
+public:
+	using value_type = std::pair<decltype(*std::declval<const Begin1&>()), decltype(*std::declval<const Begin2&>())>;
+	using difference_type = std::ptrdiff_t;
+	using reference = value_type;
+	using pointer = void;
+	using iterator_category = std::forward_iterator_tag;
+
+	ZipBegin(Begin1 b1, Begin2 b2): b1(b1), b2(b2) {}
+
+	ZipBegin& operator++() {
+		++b1;
+		++b2;
+		return *this;
+	}
+
+	reference operator*() const {
+		return reference(*b1, *b2);
+	}
+
+	const Begin1& first() const { return b1; }
+	const Begin2& second() const { return b2; }
+
+};
+
+// The zipped range ends as soon as either of the two ranges does.
+template<typename Begin1, typename Begin2, typename End1, typename End2>
+bool operator==(const ZipBegin<Begin1, Begin2>& it, const ZipEnd<End1, End2>& e) {
+	return it.first() == e.end1 || it.second() == e.end2;
+}
+
+template<typename Begin1, typename Begin2, typename End1, typename End2>
+bool operator==(const ZipEnd<End1, End2>& e, const ZipBegin<Begin1, Begin2>& it) { return it == e; }
+
+template<typename Begin1, typename Begin2, typename End1, typename End2>
+bool operator!=(const ZipBegin<Begin1, Begin2>& it, const ZipEnd<End1, End2>& e) { return !(it == e); }
+
+template<typename Begin1, typename Begin2, typename End1, typename End2>
+bool operator!=(const ZipEnd<End1, End2>& e, const ZipBegin<Begin1, Begin2>& it) { return !(it == e); }
+
+} // namespace detail
+
+template<typename Begin1, typename End1, typename Begin2, typename End2>
+class ZipRange {
+	detail::ZipBegin<Begin1, Begin2> b;
+	detail::ZipEnd<End1, End2> e;
+public:
+
+	ZipRange(Begin1 b1, End1 e1, Begin2 b2, End2 e2):
+		b(b1, b2), e{e1, e2}
+	{}
+
+	const detail::ZipBegin<Begin1, Begin2>& begin() const { return b; }
+	const detail::ZipEnd<End1, End2>& end() const { return e; }
+
+};
+
+// Walks two ranges in lock step, yielding pairs of references:
+//
+//   auto both = ph::adaptor::zip(
+//       ph::make_iterator_range(s1, ph::LazyStrIterator{}),
+//       ph::make_iterator_range(v.begin(), ph::untilValue(0)));
+template<typename Range1, typename Range2>
+auto zip(const Range1& r1, const Range2& r2) {
+	using Begin1 = typename std::decay<decltype(r1.begin())>::type;
+	using Begin2 = typename std::decay<decltype(r2.begin())>::type;
+	auto e1 = ph::anchor(r1.begin(), r1.end());
+	auto e2 = ph::anchor(r2.begin(), r2.end());
+	return ZipRange<Begin1, decltype(e1), Begin2, decltype(e2)>(r1.begin(), e1, r2.begin(), e2);
+}
+
+} } // namespace ph::adaptor
+
+#endif /* ADAPTOR_ZIP_HPP_ */
@@ -2,4 +2,11 @@
 #define ADAPTORS_HPP_
 #include "adaptor/map.hpp"
 #include "adaptor/filtered.hpp"
+#include "adaptor/split.hpp"
+#include "adaptor/zip.hpp"
+#include "adaptor/async_buffered.hpp"
+#include "adaptor/merged.hpp"
+#include "adaptor/chunk_by.hpp"
+#include "adaptor/concat.hpp"
+#include "adaptor/until.hpp"
 #endif /* ADAPTORS_HPP_ */
@@ -11,11 +11,63 @@
 #include <utility>
 #include <iterator>
 #include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
 
 #include "range.hpp"
 
 namespace ph {
 
+namespace detail {
+
+// The position an anchored end stands for, if it is a plain bound.
+template<typename Begin, typename End, typename = void>
+struct PositionOf : std::false_type {};
+
+template<typename Begin>
+struct PositionOf<Begin, Begin, typename std::enable_if<IsRandomAccess<Begin>::value>::type> : std::true_type {
+	static Begin get(const Begin& end) { return end; }
+};
+
+template<typename Begin>
+struct PositionOf<Begin, LeafNode<Begin>, typename std::enable_if<IsRandomAccess<Begin>::value>::type> : std::true_type {
+	static Begin get(const LeafNode<Begin>& end) { return end.constraint; }
+};
+
+// A counted() budget on its own is a promise that the data is that long.
+template<typename Begin>
+struct PositionOf<Begin, OffsetNode<Begin>, typename std::enable_if<IsRandomAccess<Begin>::value>::type> : std::true_type {
+	static Begin get(const OffsetNode<Begin>& end) { return end.origin + end.n; }
+};
+
+// How many of the next n elements come before the end. Positional ends are
+// answered by a subtraction, any other end is checked element by element;
+// each position is checked once and in order, as a CounterNode requires.
+template<typename Begin, typename End>
+std::ptrdiff_t available(Begin begin, End& end, std::ptrdiff_t n, std::true_type) {
+	return std::min<std::ptrdiff_t>(n, PositionOf<Begin, End>::get(end) - begin);
+}
+
+template<typename Begin, typename End>
+std::ptrdiff_t available(Begin begin, End& end, std::ptrdiff_t n, std::false_type) {
+	std::ptrdiff_t i = 0;
+	for(; i < n && begin != end; ++i, ++begin) {}
+	return i;
+}
+
+template<typename Begin, typename = void>
+struct IsArithmeticPointer : std::false_type {};
+
+template<typename T>
+struct IsArithmeticPointer<T*, typename std::enable_if<std::is_arithmetic<T>::value>::type> : std::true_type {};
+
+} // namespace detail
+
 // Non-modifying sequence operations.
 
 template<typename Iterator, typename ValueType>
@@ -25,7 +77,8 @@ Iterator find(Iterator begin, Iterator end, const ValueType& value) {
 
 template<typename Begin, typename End, typename ValueType>
 Begin find(Begin begin, End end, const ValueType& value) {
-	for(; begin != end; ++begin) {
+	auto stop = ph::anchor(begin, end);
+	for(; begin != stop; ++begin) {
 		if(*begin == value) {
 			return begin;
 		}
@@ -45,7 +98,8 @@ Iterator find_if(Iterator begin, Iterator end, UnaryPredicate p) {
 
 template<typename Begin, typename End, typename UnaryPredicate>
 Begin find_if(Begin begin, End end, UnaryPredicate p) {
-	for(; begin != end; ++begin) {
+	auto stop = ph::anchor(begin, end);
+	for(; begin != stop; ++begin) {
 		if(p(*begin))
 			return begin;
 	}
@@ -64,7 +118,8 @@ Iterator find_if_not(Iterator begin, Iterator end, UnaryPredicate p) {
 
 template<typename Begin, typename End, typename UnaryPredicate>
 Begin find_if_not(Begin begin, End end, UnaryPredicate q) {
-	for(; begin != end; ++begin) {
+	auto stop = ph::anchor(begin, end);
+	for(; begin != stop; ++begin) {
 		if(!q(*begin))
 			return begin;
 	}
@@ -78,7 +133,8 @@ bool all_of(Iterator begin, Iterator end, UnaryPredicate p) {
 
 template<typename Begin, typename End, typename UnaryPredicate>
 bool all_of(Begin begin, End end, UnaryPredicate p) {
-	return ph::find_if_not(begin, end, p) == end;
+	auto stop = ph::anchor(begin, end);
+	return ph::find_if_not(begin, stop, p) == stop;
 }
 
 template<typename Iterator, typename UnaryPredicate>
@@ -88,7 +144,8 @@ bool any_of(Iterator begin, Iterator end, UnaryPredicate p) {
 
 template<typename Begin, typename End, typename UnaryPredicate>
 bool any_of(Begin begin, End end, UnaryPredicate p) {
-	return ph::find_if(begin, end, p) != end;
+	auto stop = ph::anchor(begin, end);
+	return ph::find_if(begin, stop, p) != stop;
 }
 
 template<typename Iterator, typename UnaryPredicate>
@@ -98,7 +155,8 @@ bool none_of(Iterator begin, Iterator end, UnaryPredicate p) {
 
 template<typename Begin, typename End, typename UnaryPredicate>
 bool none_of(Begin begin, End end, UnaryPredicate p) {
-	return ph::find_if(begin, end, p) == end;
+	auto stop = ph::anchor(begin, end);
+	return ph::find_if(begin, stop, p) == stop;
 }
 
 template<typename Iterator, typename UnaryFunction>
@@ -113,7 +171,8 @@ UnaryFunction for_each(Range range, UnaryFunction f) {
 
 template<typename Begin, typename End, typename UnaryFunction>
 UnaryFunction for_each(Begin begin, End end, UnaryFunction f) {
-	for (; begin != end; ++begin) {
+	auto stop = ph::anchor(begin, end);
+	for (; begin != stop; ++begin) {
 		f(*begin);
 	}
 	return std::move(f);
@@ -127,7 +186,8 @@ typename std::iterator_traits<Iterator>::difference_type count(Iterator begin, I
 template<typename Begin, typename End, typename T>
 typename std::iterator_traits<Begin>::difference_type count(Begin begin, End end, const T& value) {
 	typename std::iterator_traits<Begin>::difference_type ret = 0;
-	for (; begin != end; ++begin) {
+	auto stop = ph::anchor(begin, end);
+	for (; begin != stop; ++begin) {
 		if (*begin == value) {
 			++ret;
 		}
@@ -143,7 +203,8 @@ typename std::iterator_traits<Iterator>::difference_type count_if(Iterator begin
 template<class Begin, class End, class UnaryPredicate>
 typename std::iterator_traits<Begin>::difference_type count_if(Begin begin, End end, UnaryPredicate p) {
 	typename std::iterator_traits<Begin>::difference_type ret = 0;
-	for (; begin != end; ++begin) {
+	auto stop = ph::anchor(begin, end);
+	for (; begin != stop; ++begin) {
 		if (p(*begin)) {
 			++ret;
 		}
@@ -158,7 +219,8 @@ bool equal(Iterator1 begin1, Iterator1 end1, Iterator2 begin2) {
 
 template<typename Begin1, typename Begin2, typename End1>
 bool equal(Begin1 begin1, End1 end1, Begin2 begin2) {
-	while (begin1 != end1) {
+	auto stop1 = ph::anchor(begin1, end1);
+	while (begin1 != stop1) {
 		if (*begin1++ != *begin2++) {
 			return false;
 		}
@@ -166,14 +228,67 @@ bool equal(Begin1 begin1, End1 end1, Begin2 begin2) {
 	return true;
 }
 
+namespace detail {
+
+// Tells the predicate overloads apart from the four iterator overloads, as
+// both take four arguments of arbitrary types.
+template<typename P, typename Begin1, typename Begin2, typename = void>
+struct IsBinaryPredicate : std::false_type {};
+
+template<typename P, typename Begin1, typename Begin2>
+struct IsBinaryPredicate<P, Begin1, Begin2, decltype(void(
+	std::declval<P&>()(*std::declval<Begin1&>(), *std::declval<Begin2&>())))> : std::true_type {};
+
+struct EqualTo {
+	template<typename T1, typename T2>
+	bool operator()(const T1& lhs, const T2& rhs) const {
+		return lhs == rhs;
+	}
+};
+
+template<typename Begin1, typename End1, typename Begin2, typename End2, typename BinaryPredicate>
+std::pair<Begin1, Begin2> mismatch(Begin1 begin1, End1 end1, Begin2 begin2, End2 end2,
+		BinaryPredicate p, std::false_type) {
+	while (begin1 != end1 && begin2 != end2 && p(*begin1, *begin2)) {
+		++begin1;
+		++begin2;
+	}
+	return std::make_pair(begin1, begin2);
+}
+
+// Two char buffers delimited by NUL or values are compared 16 bytes at a
+// time, checking for differences and for both delimiters in the same pass.
+template<typename Begin1, typename End1, typename Begin2, typename End2>
+std::pair<Begin1, Begin2> mismatch(Begin1 begin1, End1 end1, Begin2 begin2, End2 end2,
+		EqualTo p, std::true_type) {
+	const auto set1 = makeCharSet(end1);
+	const auto set2 = makeCharSet(end2);
+	if (set1.bounded || set2.bounded) {
+		return detail::mismatch(begin1, end1, begin2, end2, p, std::false_type{});
+	}
+	const auto offset = simd::mismatch(begin1, set1, begin2, set2);
+	return std::make_pair(begin1 + offset, begin2 + offset);
+}
+
+template<typename Begin1, typename End1, typename Begin2, typename End2, typename BinaryPredicate>
+using IsCharMismatch = std::integral_constant<bool,
+	std::is_same<BinaryPredicate, EqualTo>::value &&
+	IsCharPointer<Begin1>::value && IsCharPointer<Begin2>::value &&
+	CharScan<End1>::value && CharScan<End2>::value>;
+
+} // namespace detail
+
 template<typename Iterator1, typename Iterator2, typename UnaryPredicate>
-bool equal(Iterator1 begin1, Iterator1 end1, Iterator2 begin2, UnaryPredicate p) {
+typename std::enable_if<detail::IsBinaryPredicate<UnaryPredicate, Iterator1, Iterator2>::value, bool>::type
+equal(Iterator1 begin1, Iterator1 end1, Iterator2 begin2, UnaryPredicate p) {
 	return std::equal(begin1, end1, begin2, p);
 }
 
 template<typename Begin1, typename Begin2, typename End1, typename UnaryPredicate>
-bool equal(Begin1 begin1, End1 end1, Begin2 begin2, UnaryPredicate p) {
-	while (begin1 != end1) {
+typename std::enable_if<detail::IsBinaryPredicate<UnaryPredicate, Begin1, Begin2>::value, bool>::type
+equal(Begin1 begin1, End1 end1, Begin2 begin2, UnaryPredicate p) {
+	auto stop1 = ph::anchor(begin1, end1);
+	while (begin1 != stop1) {
 		if (!p(*begin1++, *begin2++)) {
 			return false;
 		}
@@ -181,18 +296,854 @@ bool equal(Begin1 begin1, End1 end1, Begin2 begin2, UnaryPredicate p) {
 	return true;
 }
 
-// TODO: 4 iterator version of equal
+template<typename Iterator1, typename Iterator2>
+std::pair<Iterator1, Iterator2> mismatch(Iterator1 begin1, Iterator1 end1, Iterator2 begin2) {
+	return std::mismatch(begin1, end1, begin2);
+}
+
+template<typename Begin1, typename End1, typename Begin2>
+std::pair<Begin1, Begin2> mismatch(Begin1 begin1, End1 end1, Begin2 begin2) {
+	auto stop1 = ph::anchor(begin1, end1);
+	while (begin1 != stop1 && *begin1 == *begin2) {
+		++begin1;
+		++begin2;
+	}
+	return std::make_pair(begin1, begin2);
+}
+
+template<typename Iterator1, typename Iterator2, typename BinaryPredicate>
+typename std::enable_if<detail::IsBinaryPredicate<BinaryPredicate, Iterator1, Iterator2>::value,
+	std::pair<Iterator1, Iterator2>>::type
+mismatch(Iterator1 begin1, Iterator1 end1, Iterator2 begin2, BinaryPredicate p) {
+	return std::mismatch(begin1, end1, begin2, p);
+}
+
+template<typename Begin1, typename End1, typename Begin2, typename BinaryPredicate>
+typename std::enable_if<detail::IsBinaryPredicate<BinaryPredicate, Begin1, Begin2>::value,
+	std::pair<Begin1, Begin2>>::type
+mismatch(Begin1 begin1, End1 end1, Begin2 begin2, BinaryPredicate p) {
+	auto stop1 = ph::anchor(begin1, end1);
+	while (begin1 != stop1 && p(*begin1, *begin2)) {
+		++begin1;
+		++begin2;
+	}
+	return std::make_pair(begin1, begin2);
+}
+
+// The four iterator versions stop at whichever range ends first, so neither
+// range has to be measured up front.
+
+template<typename Iterator1, typename Iterator2>
+typename std::enable_if<!detail::IsBinaryPredicate<Iterator2, Iterator1, Iterator2>::value,
+	std::pair<Iterator1, Iterator2>>::type
+mismatch(Iterator1 begin1, Iterator1 end1, Iterator2 begin2, Iterator2 end2) {
+	return std::mismatch(begin1, end1, begin2, end2);
+}
+
+template<typename Begin1, typename End1, typename Begin2, typename End2>
+typename std::enable_if<!detail::IsBinaryPredicate<End2, Begin1, Begin2>::value,
+	std::pair<Begin1, Begin2>>::type
+mismatch(Begin1 begin1, End1 end1, Begin2 begin2, End2 end2) {
+	auto stop1 = ph::anchor(begin1, end1);
+	auto stop2 = ph::anchor(begin2, end2);
+	return detail::mismatch(begin1, stop1, begin2, stop2, detail::EqualTo{},
+		detail::IsCharMismatch<Begin1, decltype(stop1), Begin2, decltype(stop2), detail::EqualTo>{});
+}
+
+template<typename Iterator1, typename Iterator2, typename BinaryPredicate>
+std::pair<Iterator1, Iterator2> mismatch(Iterator1 begin1, Iterator1 end1,
+		Iterator2 begin2, Iterator2 end2, BinaryPredicate p) {
+	return std::mismatch(begin1, end1, begin2, end2, p);
+}
+
+template<typename Begin1, typename End1, typename Begin2, typename End2, typename BinaryPredicate>
+std::pair<Begin1, Begin2> mismatch(Begin1 begin1, End1 end1, Begin2 begin2, End2 end2, BinaryPredicate p) {
+	auto stop1 = ph::anchor(begin1, end1);
+	auto stop2 = ph::anchor(begin2, end2);
+	return detail::mismatch(begin1, stop1, begin2, stop2, p, std::false_type{});
+}
+
+template<typename Iterator1, typename Iterator2>
+typename std::enable_if<!detail::IsBinaryPredicate<Iterator2, Iterator1, Iterator2>::value, bool>::type
+equal(Iterator1 begin1, Iterator1 end1, Iterator2 begin2, Iterator2 end2) {
+	return std::equal(begin1, end1, begin2, end2);
+}
+
+template<typename Begin1, typename End1, typename Begin2, typename End2>
+typename std::enable_if<!detail::IsBinaryPredicate<End2, Begin1, Begin2>::value, bool>::type
+equal(Begin1 begin1, End1 end1, Begin2 begin2, End2 end2) {
+	auto stop1 = ph::anchor(begin1, end1);
+	auto stop2 = ph::anchor(begin2, end2);
+	auto m = ph::mismatch(begin1, stop1, begin2, stop2);
+	return m.first == stop1 && m.second == stop2;
+}
+
+template<typename Iterator1, typename Iterator2, typename BinaryPredicate>
+bool equal(Iterator1 begin1, Iterator1 end1, Iterator2 begin2, Iterator2 end2, BinaryPredicate p) {
+	return std::equal(begin1, end1, begin2, end2, p);
+}
 
-// TODO: mismatch, and all its overloads.
+template<typename Begin1, typename End1, typename Begin2, typename End2, typename BinaryPredicate>
+bool equal(Begin1 begin1, End1 end1, Begin2 begin2, End2 end2, BinaryPredicate p) {
+	auto stop1 = ph::anchor(begin1, end1);
+	auto stop2 = ph::anchor(begin2, end2);
+	auto m = ph::mismatch(begin1, stop1, begin2, stop2, p);
+	return m.first == stop1 && m.second == stop2;
+}
 
 // TODO: find_end and all its overloads.
 
 // TODO: find_first_of and all its overloads.
 
-// TODO: adjacent_find and all its overloads.
+namespace detail {
+
+template<typename BinaryPredicate>
+struct Not {
+	BinaryPredicate p;
+
+	template<typename T1, typename T2>
+	bool operator()(const T1& a, const T2& b) const { return !p(a, b); }
+};
+
+// Comparisons the compiler can turn into vector compares of adjacent lanes.
+template<typename BinaryPredicate>
+struct IsVectorComparison : std::false_type {};
+
+template<typename T>
+struct IsVectorComparison<std::equal_to<T>> : std::true_type {};
+
+template<typename T>
+struct IsVectorComparison<std::not_equal_to<T>> : std::true_type {};
+
+template<typename BinaryPredicate>
+struct IsVectorComparison<Not<BinaryPredicate>> : IsVectorComparison<BinaryPredicate> {};
+
+template<typename Begin, typename End, typename BinaryPredicate>
+Begin adjacent_find(Begin begin, End end, BinaryPredicate p, std::false_type) {
+	auto stop = ph::anchor(begin, end);
+	if(!(begin != stop)) {
+		return begin;
+	}
+	Begin next = begin;
+	while(++next != stop) {
+		if(p(*begin, *next)) {
+			return begin;
+		}
+		begin = next;
+	}
+	return next;
+}
+
+// Contiguous arithmetic data is compared a block at a time, every element
+// with its successor and without stopping at a match, which the compiler
+// vectorises; only a block that has a match is searched element by element.
+// Every position is checked against the end once, before its block is read.
+template<typename T, typename End, typename BinaryPredicate>
+T* adjacent_find(T* begin, End end, BinaryPredicate p, std::true_type) {
+	constexpr std::ptrdiff_t block = 64;
+	auto stop = ph::anchor(begin, end);
+	using Positional = std::integral_constant<bool, PositionOf<T*, decltype(stop)>::value>;
+	T* checked = begin;
+	for(;;) {
+		checked += available(checked, stop, block + 1 - (checked - begin), Positional{});
+		if(checked - begin < block + 1) {
+			return adjacent_find(begin, checked, p, std::false_type{});
+		}
+		bool any = false;
+		for(std::ptrdiff_t i = 0; i < block; ++i) {
+			any |= p(begin[i], begin[i + 1]);
+		}
+		if(any) {
+			return adjacent_find(begin, begin + block + 1, p, std::false_type{});
+		}
+		begin += block;
+	}
+}
+
+} // namespace detail
+
+template<typename Iterator>
+Iterator adjacent_find(Iterator begin, Iterator end) {
+	return std::adjacent_find(begin, end);
+}
+
+template<typename Begin, typename End>
+Begin adjacent_find(Begin begin, End end) {
+	return detail::adjacent_find(begin, end, std::equal_to<>(), detail::IsArithmeticPointer<Begin>{});
+}
+
+template<typename Iterator, typename BinaryPredicate>
+Iterator adjacent_find(Iterator begin, Iterator end, BinaryPredicate p) {
+	return std::adjacent_find(begin, end, p);
+}
+
+template<typename Begin, typename End, typename BinaryPredicate>
+Begin adjacent_find(Begin begin, End end, BinaryPredicate p) {
+	return detail::adjacent_find(begin, end, p, std::integral_constant<bool,
+		detail::IsArithmeticPointer<Begin>::value && detail::IsVectorComparison<BinaryPredicate>::value>{});
+}
 
 // TODO: search(_n) all their overloads.
 
+// Modifying sequence operations.
+
+template<typename Iterator, typename OutputIterator>
+OutputIterator copy(Iterator begin, Iterator end, OutputIterator out) {
+	return std::copy(begin, end, out);
+}
+
+template<typename Begin, typename End, typename OutputIterator>
+OutputIterator copy(Begin begin, End end, OutputIterator out) {
+	auto stop = ph::anchor(begin, end);
+	for(; begin != stop; ++begin) {
+		*out++ = *begin;
+	}
+	return out;
+}
+
+// TODO: The other modifying sequence operations.
+
+namespace detail {
+
+// Exponential search for the first element not satisfying p, probing 1, 2,
+// 4, ... elements ahead and then searching the last step in halves, which
+// takes O(log k) comparisons for an answer k elements ahead.
+template<typename Begin, typename End, typename Predicate>
+Begin gallop(Begin begin, const End& end, Predicate p, std::true_type) {
+	const Begin last = PositionOf<Begin, End>::get(end);
+	for(std::ptrdiff_t step = 1;; step *= 2) {
+		const std::ptrdiff_t n = std::min<std::ptrdiff_t>(step, last - begin);
+		if(n <= 0) {
+			return begin;
+		}
+		const Begin probe = begin + (n - 1);
+		if(!p(*probe)) {
+			return std::partition_point(begin, probe, p);
+		}
+		begin = probe + 1;
+	}
+}
+
+// Nothing past a sentinel may be read, so every position up to a probe is
+// checked against the sentinel; the comparisons are still O(log k).
+//
+// The checks run ahead of the answer, so they are made on a copy of end:
+// a CounterNode can only be asked about positions in increasing order.
+template<typename Begin, typename End, typename Predicate>
+Begin gallop(Begin begin, const End& end, Predicate p, std::false_type) {
+	const End ahead = end;
+	for(std::ptrdiff_t step = 1;; step *= 2) {
+		Begin probe = begin;
+		Begin it = begin;
+		std::ptrdiff_t n = 0;
+		for(; n < step && it != ahead; ++n) {
+			probe = it++;
+		}
+		if(n == 0) {
+			return begin;
+		}
+		if(!p(*probe)) {
+			return std::partition_point(begin, probe, p);
+		}
+		begin = it;
+		if(n < step) {
+			return begin;
+		}
+	}
+}
+
+template<typename Begin, typename End, typename Predicate>
+Begin gallop(Begin begin, const End& end, Predicate p) {
+	return gallop(begin, end, p, std::integral_constant<bool, PositionOf<Begin, End>::value>{});
+}
+
+// Advances begin by up to n positions, stopping at end, and tells whether it
+// went all the way; begin has then not been checked against end yet.
+template<typename Begin, typename End, typename RandomAccess>
+bool skip(Begin& begin, End& end, std::ptrdiff_t n, std::true_type, RandomAccess) {
+	const std::ptrdiff_t left = PositionOf<Begin, End>::get(end) - begin;
+	begin += std::min(n, left);
+	return n < left;
+}
+
+// The steps are taken by ph::next, which scans char buffers 16 bytes at a
+// time; with the bound first, end is not asked about the step's last position.
+template<typename Begin, typename End>
+bool skip(Begin& begin, End& end, std::ptrdiff_t n, std::false_type, std::true_type) {
+	while(n > 0) {
+		const std::ptrdiff_t step = std::min<std::ptrdiff_t>(n, 4096);
+		const Begin next = ph::next(begin, ph::counted(step) || end);
+		const std::ptrdiff_t moved = next - begin;
+		begin = next;
+		if(moved < step) {
+			return false;
+		}
+		n -= step;
+	}
+	return true;
+}
+
+template<typename Begin, typename End>
+bool skip(Begin& begin, End& end, std::ptrdiff_t n, std::false_type, std::false_type) {
+	for(; n > 0; --n, ++begin) {
+		if(!(begin != end)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// A uniform random number in (0, 1], so that its logarithm is finite.
+template<typename URBG>
+double uniformPositive(URBG& g) {
+	return 1.0 - std::uniform_real_distribution<double>(0.0, 1.0)(g);
+}
+
+} // namespace detail
+
+// Sampling operations.
+
+// Writes k elements of [begin, end) chosen uniformly at random, or all of
+// them if there are fewer, in one pass over a range of unknown length.
+//
+// This is reservoir sampling with Algorithm L: after the reservoir filled
+// up, the number of elements to skip before the next replacement is drawn
+// directly, so O(k log(n / k)) random numbers are needed for n elements.
+// Positional ends are skipped in constant time, other ends are checked at
+// every skipped position.
+template<typename Begin, typename End, typename OutputIterator, typename URBG>
+OutputIterator sample(Begin begin, End end, OutputIterator out, std::size_t k, URBG&& g) {
+	using T = typename std::iterator_traits<Begin>::value_type;
+	if(k == 0) {
+		return out;
+	}
+	auto stop = ph::anchor(begin, end);
+	std::vector<T> reservoir;
+	reservoir.reserve(k);
+	for(; reservoir.size() < k && begin != stop; ++begin) {
+		reservoir.push_back(*begin);
+	}
+
+	if(reservoir.size() == k) {
+		using Positional = std::integral_constant<bool, detail::PositionOf<Begin, decltype(stop)>::value>;
+		const double maxSkip = static_cast<double>(std::numeric_limits<std::ptrdiff_t>::max() / 2);
+		std::uniform_int_distribution<std::size_t> slot(0, k - 1);
+		double w = std::exp(std::log(detail::uniformPositive(g)) / k);
+		for(;;) {
+			const double s = std::floor(std::log(detail::uniformPositive(g)) / std::log1p(-w));
+			const std::ptrdiff_t n = static_cast<std::ptrdiff_t>(s < maxSkip ? s : maxSkip);
+			if(!detail::skip(begin, stop, n, Positional{}, detail::IsRandomAccess<Begin>{}) || !(begin != stop)) {
+				break;
+			}
+			reservoir[slot(g)] = *begin;
+			++begin;
+			w *= std::exp(std::log(detail::uniformPositive(g)) / k);
+		}
+	}
+
+	return std::copy(reservoir.begin(), reservoir.end(), out);
+}
+
+// Writes k elements of [begin, end) chosen at random with probabilities
+// proportional to weight(element), without replacement; elements weighing
+// nothing are never chosen.
+//
+// This is A-ExpJ by Efraimidis and Spirakis: the weight to jump over until
+// the next replacement is drawn directly, so random numbers are only needed
+// for replacements, while the weights are summed as the range is walked.
+template<typename Begin, typename End, typename OutputIterator, typename Weight, typename URBG>
+OutputIterator weighted_sample(Begin begin, End end, OutputIterator out, std::size_t k, Weight weight, URBG&& g) {
+	using T = typename std::iterator_traits<Begin>::value_type;
+	using Entry = std::pair<double, T>;
+	if(k == 0) {
+		return out;
+	}
+	// Keys are kept as logarithms, the least key at the front of the heap.
+	auto greater = [](const Entry& a, const Entry& b) { return a.first > b.first; };
+	auto stop = ph::anchor(begin, end);
+	std::vector<Entry> reservoir;
+	reservoir.reserve(k);
+	for(; reservoir.size() < k && begin != stop; ++begin) {
+		const double w = weight(*begin);
+		if(w > 0) {
+			reservoir.emplace_back(std::log(detail::uniformPositive(g)) / w, *begin);
+			std::push_heap(reservoir.begin(), reservoir.end(), greater);
+		}
+	}
+
+	if(reservoir.size() == k) {
+		double jump = std::log(detail::uniformPositive(g)) / reservoir.front().first;
+		for(; begin != stop; ++begin) {
+			const double w = weight(*begin);
+			if(w <= 0 || (jump -= w) > 0) {
+				continue;
+			}
+			const double least = std::exp(reservoir.front().first * w);
+			const double key = std::log(std::uniform_real_distribution<double>(least, 1.0)(g)) / w;
+			std::pop_heap(reservoir.begin(), reservoir.end(), greater);
+			reservoir.back() = Entry(key, *begin);
+			std::push_heap(reservoir.begin(), reservoir.end(), greater);
+			jump = std::log(detail::uniformPositive(g)) / reservoir.front().first;
+		}
+	}
+
+	for(const Entry& entry: reservoir) {
+		*out++ = entry.second;
+	}
+	return out;
+}
+
+// Partitioning operations.
+
+template<typename Iterator, typename UnaryPredicate>
+Iterator partition_point(Iterator begin, Iterator end, UnaryPredicate p) {
+	return std::partition_point(begin, end, p);
+}
+
+template<typename Begin, typename End, typename UnaryPredicate>
+Begin partition_point(Begin begin, End end, UnaryPredicate p) {
+	return detail::gallop(begin, ph::anchor(begin, end), p);
+}
+
+// TODO: The other partitioning operations.
+
+// Sorting operations.
+
+namespace detail {
+
+template<typename Comp>
+struct Reversed {
+	Comp comp;
+
+	template<typename T1, typename T2>
+	bool operator()(const T1& a, const T2& b) const { return comp(b, a); }
+};
+
+// Keeps the k greatest elements seen so far in a buffer of 2k. Whenever the
+// buffer fills up, nth_element drops its lesser half, and the least element
+// kept becomes the threshold that rejects most later elements with a single
+// comparison, so n elements cost O(n) time and O(k) memory.
+template<typename T, typename Comp>
+class TopK {
+	std::vector<T> buffer;
+	std::size_t k;
+	Reversed<Comp> greater;
+	bool full = false;
+
+	void shrink() {
+		std::nth_element(buffer.begin(), buffer.begin() + (k - 1), buffer.end(), greater);
+		buffer.erase(buffer.begin() + k, buffer.end());
+		full = true;
+	}
+
+public:
+	TopK(std::size_t k, Comp comp): k(k), greater{comp} {
+		buffer.reserve(2 * k);
+	}
+
+	void push(const T& value) {
+		if(full && !greater.comp(buffer[k - 1], value)) {
+			return;
+		}
+		buffer.push_back(value);
+		if(buffer.size() == 2 * k) {
+			shrink();
+		}
+	}
+
+	// The greatest elements, greatest first.
+	std::vector<T> take() {
+		if(buffer.size() > k) {
+			shrink();
+		}
+		std::sort(buffer.begin(), buffer.end(), greater);
+		return std::move(buffer);
+	}
+};
+
+} // namespace detail
+
+// The k greatest elements of [begin, end) by comp, greatest first, or all of
+// them if there are fewer; found in one pass without measuring the range.
+template<typename Begin, typename End, typename Comp>
+std::vector<typename std::iterator_traits<Begin>::value_type> top_k(Begin begin, End end, std::size_t k, Comp comp) {
+	using T = typename std::iterator_traits<Begin>::value_type;
+	if(k == 0) {
+		return {};
+	}
+	detail::TopK<T, Comp> top(k, comp);
+	auto stop = ph::anchor(begin, end);
+	for(; begin != stop; ++begin) {
+		top.push(*begin);
+	}
+	return top.take();
+}
+
+template<typename Begin, typename End>
+std::vector<typename std::iterator_traits<Begin>::value_type> top_k(Begin begin, End end, std::size_t k) {
+	return ph::top_k(begin, end, k, std::less<>());
+}
+
+// The element that would be at position n if [begin, end) was sorted by
+// comp. Throws std::out_of_range if the range holds n elements or less,
+// which is only known once it was walked.
+template<typename Begin, typename End, typename Comp>
+typename std::iterator_traits<Begin>::value_type nth_smallest(Begin begin, End end, std::size_t n, Comp comp) {
+	auto smallest = ph::top_k(begin, end, n + 1, detail::Reversed<Comp>{comp});
+	if(smallest.size() <= n) {
+		throw std::out_of_range("ph::nth_smallest: the range holds n elements or less");
+	}
+	return smallest.back();
+}
+
+template<typename Begin, typename End>
+typename std::iterator_traits<Begin>::value_type nth_smallest(Begin begin, End end, std::size_t n) {
+	return ph::nth_smallest(begin, end, n, std::less<>());
+}
+
+// TODO: The other sorting operations.
+
+// Binary search operations (on sorted ranges).
+//
+// Without a known length these search outwards from begin, so they are
+// cheapest for answers close to begin.
+
+template<typename Iterator, typename T>
+Iterator lower_bound(Iterator begin, Iterator end, const T& value) {
+	return std::lower_bound(begin, end, value);
+}
+
+template<typename Begin, typename End, typename T>
+Begin lower_bound(Begin begin, End end, const T& value) {
+	return detail::gallop(begin, ph::anchor(begin, end), [&value](const auto& x) { return x < value; });
+}
+
+template<typename Iterator, typename T, typename Compare>
+Iterator lower_bound(Iterator begin, Iterator end, const T& value, Compare comp) {
+	return std::lower_bound(begin, end, value, comp);
+}
+
+template<typename Begin, typename End, typename T, typename Compare>
+Begin lower_bound(Begin begin, End end, const T& value, Compare comp) {
+	return detail::gallop(begin, ph::anchor(begin, end), [&value, &comp](const auto& x) { return comp(x, value); });
+}
+
+template<typename Iterator, typename T>
+Iterator upper_bound(Iterator begin, Iterator end, const T& value) {
+	return std::upper_bound(begin, end, value);
+}
+
+template<typename Begin, typename End, typename T>
+Begin upper_bound(Begin begin, End end, const T& value) {
+	return detail::gallop(begin, ph::anchor(begin, end), [&value](const auto& x) { return !(value < x); });
+}
+
+template<typename Iterator, typename T, typename Compare>
+Iterator upper_bound(Iterator begin, Iterator end, const T& value, Compare comp) {
+	return std::upper_bound(begin, end, value, comp);
+}
+
+template<typename Begin, typename End, typename T, typename Compare>
+Begin upper_bound(Begin begin, End end, const T& value, Compare comp) {
+	return detail::gallop(begin, ph::anchor(begin, end), [&value, &comp](const auto& x) { return !comp(value, x); });
+}
+
+template<typename Iterator, typename T>
+std::pair<Iterator, Iterator> equal_range(Iterator begin, Iterator end, const T& value) {
+	return std::equal_range(begin, end, value);
+}
+
+template<typename Begin, typename End, typename T>
+std::pair<Begin, Begin> equal_range(Begin begin, End end, const T& value) {
+	auto stop = ph::anchor(begin, end);
+	const Begin lower = detail::gallop(begin, stop, [&value](const auto& x) { return x < value; });
+	return std::make_pair(lower, detail::gallop(lower, stop, [&value](const auto& x) { return !(value < x); }));
+}
+
+template<typename Iterator, typename T, typename Compare>
+std::pair<Iterator, Iterator> equal_range(Iterator begin, Iterator end, const T& value, Compare comp) {
+	return std::equal_range(begin, end, value, comp);
+}
+
+template<typename Begin, typename End, typename T, typename Compare>
+std::pair<Begin, Begin> equal_range(Begin begin, End end, const T& value, Compare comp) {
+	auto stop = ph::anchor(begin, end);
+	const Begin lower = detail::gallop(begin, stop, [&value, &comp](const auto& x) { return comp(x, value); });
+	return std::make_pair(lower, detail::gallop(lower, stop, [&value, &comp](const auto& x) { return !comp(value, x); }));
+}
+
+template<typename Iterator, typename T>
+bool binary_search(Iterator begin, Iterator end, const T& value) {
+	return std::binary_search(begin, end, value);
+}
+
+template<typename Begin, typename End, typename T>
+bool binary_search(Begin begin, End end, const T& value) {
+	auto stop = ph::anchor(begin, end);
+	begin = ph::lower_bound(begin, stop, value);
+	return begin != stop && !(value < *begin);
+}
+
+template<typename Iterator, typename T, typename Compare>
+bool binary_search(Iterator begin, Iterator end, const T& value, Compare comp) {
+	return std::binary_search(begin, end, value, comp);
+}
+
+template<typename Begin, typename End, typename T, typename Compare>
+bool binary_search(Begin begin, End end, const T& value, Compare comp) {
+	auto stop = ph::anchor(begin, end);
+	begin = ph::lower_bound(begin, stop, value, comp);
+	return begin != stop && !comp(value, *begin);
+}
+
+namespace detail {
+
+struct Less {
+	template<typename T1, typename T2>
+	bool operator()(const T1& lhs, const T2& rhs) const {
+		return lhs < rhs;
+	}
+};
+
+// After this many steps in a row on one side an intersection stops merging
+// and gallops that side forward, which makes skewed sizes cost O(m log(n/m))
+// rather than O(n + m).
+static const int gallopAfter = 8;
+
+template<typename Begin1, typename End1, typename Begin2, typename End2, typename OutputIterator, typename Compare>
+OutputIterator set_intersection(Begin1 begin1, End1 end1, Begin2 begin2, End2 end2,
+		OutputIterator out, Compare comp, std::false_type) {
+	int run1 = 0;
+	int run2 = 0;
+	while(begin1 != end1 && begin2 != end2) {
+		if(comp(*begin1, *begin2)) {
+			++begin1;
+			run2 = 0;
+			if(++run1 == gallopAfter) {
+				begin1 = detail::gallop(begin1, end1, [&begin2, &comp](const auto& x) { return comp(x, *begin2); });
+				run1 = 0;
+			}
+		} else if(comp(*begin2, *begin1)) {
+			++begin2;
+			run1 = 0;
+			if(++run2 == gallopAfter) {
+				begin2 = detail::gallop(begin2, end2, [&begin1, &comp](const auto& x) { return comp(x, *begin1); });
+				run2 = 0;
+			}
+		} else {
+			*out++ = *begin1;
+			++begin1;
+			++begin2;
+			run1 = run2 = 0;
+		}
+	}
+	return out;
+}
+
+// Contiguous 32 bit integers are compared four against four. Blocks without
+// a common value are skipped whole, the others are merged element by
+// element, so duplicates are handled exactly like in the scalar version.
+template<typename Begin1, typename End1, typename Begin2, typename End2, typename OutputIterator>
+OutputIterator set_intersection(Begin1 begin1, End1 end1, Begin2 begin2, End2 end2,
+		OutputIterator out, Less comp, std::true_type) {
+	const Begin1 last1 = PositionOf<Begin1, End1>::get(end1);
+	const Begin2 last2 = PositionOf<Begin2, End2>::get(end2);
+	int run1 = 0;
+	int run2 = 0;
+	while(last1 - begin1 >= 4 && last2 - begin2 >= 4) {
+		if(!simd::anyEqual4(begin1, begin2)) {
+			if(begin1[3] < begin2[3]) {
+				begin1 += 4;
+				run2 = 0;
+				if(++run1 == gallopAfter) {
+					begin1 = detail::gallop(begin1, last1, [&begin2](const auto& x) { return x < *begin2; });
+					run1 = 0;
+				}
+			} else {
+				begin2 += 4;
+				run1 = 0;
+				if(++run2 == gallopAfter) {
+					begin2 = detail::gallop(begin2, last2, [&begin1](const auto& x) { return x < *begin1; });
+					run2 = 0;
+				}
+			}
+		} else {
+			const Begin1 block1 = begin1 + 4;
+			const Begin2 block2 = begin2 + 4;
+			while(begin1 != block1 && begin2 != block2) {
+				if(*begin1 < *begin2) {
+					++begin1;
+				} else if(*begin2 < *begin1) {
+					++begin2;
+				} else {
+					*out++ = *begin1;
+					++begin1;
+					++begin2;
+				}
+			}
+			run1 = run2 = 0;
+		}
+	}
+	return detail::set_intersection(begin1, last1, begin2, last2, out, comp, std::false_type{});
+}
+
+template<typename Begin1, typename End1, typename Begin2, typename End2, typename Compare>
+using IsIntIntersection = std::integral_constant<bool,
+	std::is_same<Compare, Less>::value &&
+	std::is_pointer<Begin1>::value && std::is_same<Begin1, Begin2>::value &&
+	std::is_integral<typename std::iterator_traits<Begin1>::value_type>::value &&
+	sizeof(typename std::iterator_traits<Begin1>::value_type) == 4 &&
+	PositionOf<Begin1, End1>::value && PositionOf<Begin2, End2>::value>;
+
+template<typename Begin1, typename End1, typename Begin2, typename End2, typename OutputIterator, typename Compare>
+OutputIterator set_intersection(Begin1 begin1, End1 end1, Begin2 begin2, End2 end2,
+		OutputIterator out, Compare comp) {
+	auto stop1 = ph::anchor(begin1, end1);
+	auto stop2 = ph::anchor(begin2, end2);
+	return detail::set_intersection(begin1, stop1, begin2, stop2, out, comp,
+			IsIntIntersection<Begin1, decltype(stop1), Begin2, decltype(stop2), Compare>{});
+}
+
+template<typename Begin1, typename End1, typename Begin2, typename End2, typename OutputIterator, typename Compare>
+OutputIterator merge(Begin1 begin1, End1 end1, Begin2 begin2, End2 end2,
+		OutputIterator out, Compare comp) {
+	auto stop1 = ph::anchor(begin1, end1);
+	auto stop2 = ph::anchor(begin2, end2);
+	while(begin1 != stop1 && begin2 != stop2) {
+		if(comp(*begin2, *begin1)) {
+			*out++ = *begin2++;
+		} else {
+			*out++ = *begin1++;
+		}
+	}
+	return ph::copy(begin2, stop2, ph::copy(begin1, stop1, out));
+}
+
+template<typename Begin1, typename End1, typename Begin2, typename End2, typename OutputIterator, typename Compare>
+OutputIterator set_union(Begin1 begin1, End1 end1, Begin2 begin2, End2 end2,
+		OutputIterator out, Compare comp) {
+	auto stop1 = ph::anchor(begin1, end1);
+	auto stop2 = ph::anchor(begin2, end2);
+	while(begin1 != stop1 && begin2 != stop2) {
+		if(comp(*begin1, *begin2)) {
+			*out++ = *begin1++;
+		} else if(comp(*begin2, *begin1)) {
+			*out++ = *begin2++;
+		} else {
+			*out++ = *begin1++;
+			++begin2;
+		}
+	}
+	return ph::copy(begin2, stop2, ph::copy(begin1, stop1, out));
+}
+
+template<typename Begin1, typename End1, typename Begin2, typename End2, typename OutputIterator, typename Compare>
+OutputIterator set_difference(Begin1 begin1, End1 end1, Begin2 begin2, End2 end2,
+		OutputIterator out, Compare comp) {
+	auto stop1 = ph::anchor(begin1, end1);
+	auto stop2 = ph::anchor(begin2, end2);
+	while(begin1 != stop1 && begin2 != stop2) {
+		if(comp(*begin1, *begin2)) {
+			*out++ = *begin1++;
+		} else if(comp(*begin2, *begin1)) {
+			++begin2;
+		} else {
+			++begin1;
+			++begin2;
+		}
+	}
+	return ph::copy(begin1, stop1, out);
+}
+
+} // namespace detail
+
+// Merge operations (on sorted ranges).
+
+template<typename Iterator1, typename Iterator2, typename OutputIterator>
+OutputIterator merge(Iterator1 begin1, Iterator1 end1, Iterator2 begin2, Iterator2 end2, OutputIterator out) {
+	return std::merge(begin1, end1, begin2, end2, out);
+}
+
+template<typename Begin1, typename End1, typename Begin2, typename End2, typename OutputIterator>
+OutputIterator merge(Begin1 begin1, End1 end1, Begin2 begin2, End2 end2, OutputIterator out) {
+	return detail::merge(begin1, end1, begin2, end2, out, detail::Less{});
+}
+
+template<typename Iterator1, typename Iterator2, typename OutputIterator, typename Compare>
+OutputIterator merge(Iterator1 begin1, Iterator1 end1, Iterator2 begin2, Iterator2 end2, OutputIterator out, Compare comp) {
+	return std::merge(begin1, end1, begin2, end2, out, comp);
+}
+
+template<typename Begin1, typename End1, typename Begin2, typename End2, typename OutputIterator, typename Compare>
+OutputIterator merge(Begin1 begin1, End1 end1, Begin2 begin2, End2 end2, OutputIterator out, Compare comp) {
+	return detail::merge(begin1, end1, begin2, end2, out, comp);
+}
+
+// TODO: inplace_merge
+
+// Set operations (on sorted ranges).
+
+template<typename Iterator1, typename Iterator2, typename OutputIterator>
+OutputIterator set_intersection(Iterator1 begin1, Iterator1 end1, Iterator2 begin2, Iterator2 end2, OutputIterator out) {
+	return std::set_intersection(begin1, end1, begin2, end2, out);
+}
+
+template<typename Begin1, typename End1, typename Begin2, typename End2, typename OutputIterator>
+OutputIterator set_intersection(Begin1 begin1, End1 end1, Begin2 begin2, End2 end2, OutputIterator out) {
+	return detail::set_intersection(begin1, end1, begin2, end2, out, detail::Less{});
+}
+
+template<typename Iterator1, typename Iterator2, typename OutputIterator, typename Compare>
+OutputIterator set_intersection(Iterator1 begin1, Iterator1 end1, Iterator2 begin2, Iterator2 end2, OutputIterator out, Compare comp) {
+	return std::set_intersection(begin1, end1, begin2, end2, out, comp);
+}
+
+template<typename Begin1, typename End1, typename Begin2, typename End2, typename OutputIterator, typename Compare>
+OutputIterator set_intersection(Begin1 begin1, End1 end1, Begin2 begin2, End2 end2, OutputIterator out, Compare comp) {
+	return detail::set_intersection(begin1, end1, begin2, end2, out, comp);
+}
+
+template<typename Iterator1, typename Iterator2, typename OutputIterator>
+OutputIterator set_union(Iterator1 begin1, Iterator1 end1, Iterator2 begin2, Iterator2 end2, OutputIterator out) {
+	return std::set_union(begin1, end1, begin2, end2, out);
+}
+
+template<typename Begin1, typename End1, typename Begin2, typename End2, typename OutputIterator>
+OutputIterator set_union(Begin1 begin1, End1 end1, Begin2 begin2, End2 end2, OutputIterator out) {
+	return detail::set_union(begin1, end1, begin2, end2, out, detail::Less{});
+}
+
+template<typename Iterator1, typename Iterator2, typename OutputIterator, typename Compare>
+OutputIterator set_union(Iterator1 begin1, Iterator1 end1, Iterator2 begin2, Iterator2 end2, OutputIterator out, Compare comp) {
+	return std::set_union(begin1, end1, begin2, end2, out, comp);
+}
+
+template<typename Begin1, typename End1, typename Begin2, typename End2, typename OutputIterator, typename Compare>
+OutputIterator set_union(Begin1 begin1, End1 end1, Begin2 begin2, End2 end2, OutputIterator out, Compare comp) {
+	return detail::set_union(begin1, end1, begin2, end2, out, comp);
+}
+
+template<typename Iterator1, typename Iterator2, typename OutputIterator>
+OutputIterator set_difference(Iterator1 begin1, Iterator1 end1, Iterator2 begin2, Iterator2 end2, OutputIterator out) {
+	return std::set_difference(begin1, end1, begin2, end2, out);
+}
+
+template<typename Begin1, typename End1, typename Begin2, typename End2, typename OutputIterator>
+OutputIterator set_difference(Begin1 begin1, End1 end1, Begin2 begin2, End2 end2, OutputIterator out) {
+	return detail::set_difference(begin1, end1, begin2, end2, out, detail::Less{});
+}
+
+template<typename Iterator1, typename Iterator2, typename OutputIterator, typename Compare>
+OutputIterator set_difference(Iterator1 begin1, Iterator1 end1, Iterator2 begin2, Iterator2 end2, OutputIterator out, Compare comp) {
+	return std::set_difference(begin1, end1, begin2, end2, out, comp);
+}
+
+template<typename Begin1, typename End1, typename Begin2, typename End2, typename OutputIterator, typename Compare>
+OutputIterator set_difference(Begin1 begin1, End1 end1, Begin2 begin2, End2 end2, OutputIterator out, Compare comp) {
+	return detail::set_difference(begin1, end1, begin2, end2, out, comp);
+}
+
+// TODO: includes and set_symmetric_difference
 
 // TODO: Other operation categories.
 
@@ -203,9 +1154,13 @@ Iterator max_element(Iterator begin, Iterator end) {
 
 template<typename Begin, typename End>
 Begin max_element(Begin begin, End end) {
+	auto stop = ph::anchor(begin, end);
+	if(!(begin != stop)) {
+		return begin;
+	}
 	Begin answerIterator = begin++;
 
-	for(; begin != end; ++begin) {
+	for(; begin != stop; ++begin) {
 		if(*answerIterator < *begin)
 			answerIterator = begin;
 	}
@@ -220,9 +1175,13 @@ Iterator max_element(Iterator begin, Iterator end, Comp comp) {
 
 template<typename Begin, typename End, typename Comp>
 Begin max_element(Begin begin, End end, Comp comp) {
+	auto stop = ph::anchor(begin, end);
+	if(!(begin != stop)) {
+		return begin;
+	}
 	Begin answerIterator = begin++;
 
-	for(; begin != end; ++begin) {
+	for(; begin != stop; ++begin) {
 		if(comp(*answerIterator, *begin))
 			answerIterator = begin;
 	}
@@ -237,9 +1196,13 @@ Iterator min_element(Iterator begin, Iterator end) {
 
 template<typename Begin, typename End>
 Begin min_element(Begin begin, End end) {
+	auto stop = ph::anchor(begin, end);
+	if(!(begin != stop)) {
+		return begin;
+	}
 	Begin answerIterator = begin++;
 
-	for(; begin != end; ++begin) {
+	for(; begin != stop; ++begin) {
 		if(*begin < *answerIterator)
 			answerIterator = begin;
 	}
@@ -254,9 +1217,13 @@ Iterator min_element(Iterator begin, Iterator end, Comp comp) {
 
 template<typename Begin, typename End, typename Comp>
 Begin min_element(Begin begin, End end, Comp comp) {
+	auto stop = ph::anchor(begin, end);
+	if(!(begin != stop)) {
+		return begin;
+	}
 	Begin answerIterator = begin++;
 
-	for(; begin != end; ++begin) {
+	for(; begin != stop; ++begin) {
 		if(comp(*begin, *answerIterator))
 			answerIterator = begin;
 	}
@@ -264,6 +1231,174 @@ Begin min_element(Begin begin, End end, Comp comp) {
 	return answerIterator;
 }
 
+namespace detail {
+
+// Visits the elements two at a time: the smaller one of a pair is compared
+// with the minimum only and the larger one with the maximum only, which is
+// 3 comparisons per 2 elements. Like std::minmax_element, the result holds
+// the first smallest and the last largest element.
+template<typename Begin, typename End, typename Comp>
+std::pair<Begin, Begin> minmax_element(Begin begin, End end, Comp comp, std::false_type) {
+	auto stop = ph::anchor(begin, end);
+	if(!(begin != stop)) {
+		return {begin, begin};
+	}
+	Begin min = begin;
+	Begin max = begin;
+	while(++begin != stop) {
+		const Begin first = begin;
+		if(!(++begin != stop)) {
+			if(comp(*first, *min)) {
+				min = first;
+			} else if(!comp(*first, *max)) {
+				max = first;
+			}
+			break;
+		}
+		if(comp(*begin, *first)) {
+			if(comp(*begin, *min)) {
+				min = begin;
+			}
+			if(!comp(*first, *max)) {
+				max = first;
+			}
+		} else {
+			if(comp(*first, *min)) {
+				min = first;
+			}
+			if(!comp(*begin, *max)) {
+				max = begin;
+			}
+		}
+	}
+	return {min, max};
+}
+
+// The extreme values of a block of arithmetic values, kept in independent
+// lanes so that the compiler turns the selects into vector min and max.
+template<typename T>
+struct Extremes {
+	static constexpr std::ptrdiff_t lanes = 16;
+	static constexpr std::ptrdiff_t block = 16 * lanes;
+
+	T min;
+	T max;
+
+	Extremes(const T* p, std::ptrdiff_t n): min(p[0]), max(p[0]) {
+		std::ptrdiff_t i = 0;
+		if(n == block) {
+			T lo[lanes];
+			T hi[lanes];
+			for(std::ptrdiff_t j = 0; j < lanes; ++j) {
+				lo[j] = hi[j] = p[j];
+			}
+			for(i = lanes; i < block; i += lanes) {
+				for(std::ptrdiff_t j = 0; j < lanes; ++j) {
+					lo[j] = p[i + j] < lo[j] ? p[i + j] : lo[j];
+					hi[j] = hi[j] < p[i + j] ? p[i + j] : hi[j];
+				}
+			}
+			for(std::ptrdiff_t j = 0; j < lanes; ++j) {
+				min = lo[j] < min ? lo[j] : min;
+				max = max < hi[j] ? hi[j] : max;
+			}
+			return;
+		}
+		for(; i < n; ++i) {
+			min = p[i] < min ? p[i] : min;
+			max = max < p[i] ? p[i] : max;
+		}
+	}
+};
+
+// Contiguous arithmetic data is reduced to the extreme values of every
+// block, remembering the blocks holding the first minimum and the last
+// maximum; the positions are then recovered by scanning just those two.
+// A NaN can leave an extreme value that equals no element of its block, in
+// which case the pairwise scan decides instead.
+template<typename T, typename End>
+std::pair<T*, T*> minmax_element(T* begin, End end, std::less<>, std::true_type) {
+	using Value = typename std::remove_const<T>::type;
+	using Block = Extremes<Value>;
+	auto stop = ph::anchor(begin, end);
+	using Positional = std::integral_constant<bool, PositionOf<T*, decltype(stop)>::value>;
+
+	T* p = begin;
+	std::ptrdiff_t n = available(p, stop, Block::block, Positional{});
+	if(n == 0) {
+		return {begin, begin};
+	}
+	Block extremes(p, n);
+	T* minBlock = p;
+	T* maxBlock = p;
+	std::ptrdiff_t minLength = n;
+	std::ptrdiff_t maxLength = n;
+	while(n == Block::block) {
+		p += n;
+		n = available(p, stop, Block::block, Positional{});
+		if(n == 0) {
+			break;
+		}
+		const Block next(p, n);
+		if(next.min < extremes.min) {
+			extremes.min = next.min;
+			minBlock = p;
+			minLength = n;
+		}
+		if(!(next.max < extremes.max)) {
+			extremes.max = next.max;
+			maxBlock = p;
+			maxLength = n;
+		}
+	}
+
+	T* min = minBlock;
+	for(; min != minBlock + minLength && !(*min == extremes.min); ++min) {}
+	T* max = maxBlock + maxLength;
+	for(; max != maxBlock && !(*(max - 1) == extremes.max); --max) {}
+	if(min == minBlock + minLength || max == maxBlock) {
+		return minmax_element(begin, end, std::less<>(), std::false_type{});
+	}
+	return {min, max - 1};
+}
+
+} // namespace detail
+
+template<typename Iterator>
+std::pair<Iterator, Iterator> minmax_element(Iterator begin, Iterator end) {
+	return std::minmax_element(begin, end);
+}
+
+template<typename Begin, typename End>
+std::pair<Begin, Begin> minmax_element(Begin begin, End end) {
+	return detail::minmax_element(begin, end, std::less<>(), detail::IsArithmeticPointer<Begin>{});
+}
+
+template<typename Iterator, typename Comp>
+std::pair<Iterator, Iterator> minmax_element(Iterator begin, Iterator end, Comp comp) {
+	return std::minmax_element(begin, end, comp);
+}
+
+template<typename Begin, typename End, typename Comp>
+std::pair<Begin, Begin> minmax_element(Begin begin, End end, Comp comp) {
+	return detail::minmax_element(begin, end, comp, std::false_type{});
+}
+
+// The smallest and the largest value of a non-empty range.
+template<typename Begin, typename End>
+std::pair<typename std::iterator_traits<Begin>::value_type, typename std::iterator_traits<Begin>::value_type>
+minmax(Begin begin, End end) {
+	const auto extremes = ph::minmax_element(begin, end);
+	return {*extremes.first, *extremes.second};
+}
+
+template<typename Begin, typename End, typename Comp>
+std::pair<typename std::iterator_traits<Begin>::value_type, typename std::iterator_traits<Begin>::value_type>
+minmax(Begin begin, End end, Comp comp) {
+	const auto extremes = ph::minmax_element(begin, end, comp);
+	return {*extremes.first, *extremes.second};
+}
+
 } // namespace ph
 
 #endif /* ALGORITHM_HPP_ */
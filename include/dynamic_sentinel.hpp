@@ -0,0 +1,289 @@
+#ifndef DYNAMIC_SENTINEL_HPP_
+#define DYNAMIC_SENTINEL_HPP_
+
+// A stop condition built at runtime, e.g. from configuration, that behaves
+// like the compile time node trees of ph.hpp.
+//
+// Expressions are written in a small language:
+//
+//   expr       := term { "||" term }
+//   term       := factor { "&&" factor }
+//   factor     := "!" factor | "(" expr ")" | comparison
+//   comparison := [ "==" | "!=" | "<" | "<=" | ">" | ">=" ] value
+//
+// so "100 || 200 || (>= 500 && < 600)" stops at 100, at 200, and at anything
+// in [500, 600). A bare value means "==". Parentheses and "!" nest at most
+// 256 deep; chains of "||" and "&&" may be of any length.
+//
+// The expression is compiled into a flat array of compare-and-branch
+// instructions, where every comparison names the instruction to continue
+// with on success and on failure; short circuiting is therefore part of the
+// code and evaluating it is a simple loop without any indirect calls.
+// Expressions that are only a set of "==" alternatives skip the instructions
+// and go to a ph::ValueSet instead.
+
+#include <cctype>
+#include <cstddef>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "ph.hpp"
+#include "ValueSet.hpp"
+
+namespace ph {
+
+namespace detail {
+
+enum class StopOp { Equal, NotEqual, Less, LessEqual, Greater, GreaterEqual };
+
+// And and Or hold all the operands of a chain like "1 || 2 || 3", so the
+// depth of the tree, and of the recursion over it, is the nesting depth of
+// the text rather than its length.
+template<typename T>
+struct StopExpr {
+	enum Kind { Compare, And, Or, Not } kind;
+	StopOp op;
+	T value;
+	std::vector<std::unique_ptr<StopExpr>> operands;
+};
+
+template<typename T>
+class StopExprParser {
+	static const std::size_t maxDepth = 256;
+
+	const std::string& text;
+	std::size_t pos = 0;
+	std::size_t depth = 0;
+
+	using Expr = std::unique_ptr<StopExpr<T>>;
+
+	void skipSpace() {
+		while(pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) {
+			++pos;
+		}
+	}
+
+	bool accept(const char* token) {
+		skipSpace();
+		const std::string t(token);
+		if(text.compare(pos, t.size(), t) == 0) {
+			pos += t.size();
+			return true;
+		}
+		return false;
+	}
+
+	[[noreturn]] void fail(const std::string& what) const {
+		throw std::invalid_argument("dynamic_sentinel: " + what + " at offset " +
+				std::to_string(pos) + " of \"" + text + "\"");
+	}
+
+	static Expr node(typename StopExpr<T>::Kind kind, Expr operand) {
+		Expr e(new StopExpr<T>{kind, StopOp::Equal, T(), {}});
+		e->operands.push_back(std::move(operand));
+		return e;
+	}
+
+	Expr parseExpr() {
+		Expr e = parseTerm();
+		if(accept("||")) {
+			e = node(StopExpr<T>::Or, std::move(e));
+			do {
+				e->operands.push_back(parseTerm());
+			} while(accept("||"));
+		}
+		return e;
+	}
+
+	Expr parseTerm() {
+		Expr e = parseFactor();
+		if(accept("&&")) {
+			e = node(StopExpr<T>::And, std::move(e));
+			do {
+				e->operands.push_back(parseFactor());
+			} while(accept("&&"));
+		}
+		return e;
+	}
+
+	Expr parseFactor() {
+		if(accept("!=")) {
+			return parseValue(StopOp::NotEqual);
+		}
+		if(accept("!")) {
+			enter();
+			Expr e = node(StopExpr<T>::Not, parseFactor());
+			--depth;
+			return e;
+		}
+		if(accept("(")) {
+			enter();
+			Expr e = parseExpr();
+			if(!accept(")")) {
+				fail("expected ')'");
+			}
+			--depth;
+			return e;
+		}
+		if(accept("==")) return parseValue(StopOp::Equal);
+		if(accept("<=")) return parseValue(StopOp::LessEqual);
+		if(accept(">=")) return parseValue(StopOp::GreaterEqual);
+		if(accept("<")) return parseValue(StopOp::Less);
+		if(accept(">")) return parseValue(StopOp::Greater);
+		return parseValue(StopOp::Equal);
+	}
+
+	Expr parseValue(StopOp op) {
+		skipSpace();
+		std::size_t end = pos;
+		while(end < text.size() && !std::isspace(static_cast<unsigned char>(text[end])) &&
+				text[end] != ')' && text[end] != '|' && text[end] != '&') {
+			++end;
+		}
+		std::istringstream stream(text.substr(pos, end - pos));
+		T value;
+		if(end == pos || !(stream >> value) || !stream.eof()) {
+			fail("expected a value");
+		}
+		pos = end;
+		Expr e(new StopExpr<T>{StopExpr<T>::Compare, op, value, {}});
+		return e;
+	}
+
+	void enter() {
+		if(++depth > maxDepth) {
+			fail("nesting too deep");
+		}
+	}
+
+public:
+	explicit StopExprParser(const std::string& text): text(text) {}
+
+	Expr parse() {
+		Expr e = parseExpr();
+		skipSpace();
+		if(pos != text.size()) {
+			fail("unexpected input");
+		}
+		return e;
+	}
+};
+
+} // namespace detail
+
+template<typename T>
+class dynamic_sentinel {
+	enum : int { False = -1, True = -2 };
+
+	struct Instruction {
+		detail::StopOp op;
+		T value;
+		int onTrue;
+		int onFalse;
+	};
+
+	std::vector<Instruction> code;
+	int entry = False;
+
+	bool isValueSet = false;
+	ValueSet<T> values;
+
+	// Emits the code for e, continuing at onTrue or onFalse, and returns the
+	// instruction to start e with. Operands are emitted right to left, so
+	// every jump target already exists when a jump to it is emitted.
+	int compile(const detail::StopExpr<T>& e, int onTrue, int onFalse) {
+		switch(e.kind) {
+		case detail::StopExpr<T>::Compare:
+			code.push_back(Instruction{e.op, e.value, onTrue, onFalse});
+			return static_cast<int>(code.size() - 1);
+		case detail::StopExpr<T>::Or:
+			for(auto o = e.operands.rbegin(); o != e.operands.rend(); ++o) {
+				onFalse = compile(**o, onTrue, onFalse);
+			}
+			return onFalse;
+		case detail::StopExpr<T>::And:
+			for(auto o = e.operands.rbegin(); o != e.operands.rend(); ++o) {
+				onTrue = compile(**o, onTrue, onFalse);
+			}
+			return onTrue;
+		case detail::StopExpr<T>::Not:
+			return compile(*e.operands.front(), onFalse, onTrue);
+		}
+		return onFalse;
+	}
+
+	static bool collectValues(const detail::StopExpr<T>& e, std::vector<T>& values) {
+		if(e.kind == detail::StopExpr<T>::Compare && e.op == detail::StopOp::Equal) {
+			values.push_back(e.value);
+			return true;
+		}
+		if(e.kind != detail::StopExpr<T>::Or) {
+			return false;
+		}
+		for(const auto& o: e.operands) {
+			if(!collectValues(*o, values)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	static bool compare(detail::StopOp op, const T& lhs, const T& rhs) {
+		switch(op) {
+		case detail::StopOp::Equal: return lhs == rhs;
+		case detail::StopOp::NotEqual: return !(lhs == rhs);
+		case detail::StopOp::Less: return lhs < rhs;
+		case detail::StopOp::LessEqual: return !(rhs < lhs);
+		case detail::StopOp::Greater: return rhs < lhs;
+		case detail::StopOp::GreaterEqual: return !(lhs < rhs);
+		}
+		return false;
+	}
+
+public:
+	// Throws std::invalid_argument if the expression does not parse.
+	explicit dynamic_sentinel(const std::string& expression) {
+		auto e = detail::StopExprParser<T>(expression).parse();
+		std::vector<T> collected;
+		if(collectValues(*e, collected)) {
+			isValueSet = true;
+			values = ValueSet<T>(collected.begin(), collected.end());
+		} else {
+			entry = compile(*e, True, False);
+		}
+	}
+
+	bool matches(const T& v) const {
+		if(isValueSet) {
+			return values.contains(v);
+		}
+		int pc = entry;
+		while(pc >= 0) {
+			const Instruction& i = code[pc];
+			pc = compare(i.op, v, i.value) ? i.onTrue : i.onFalse;
+		}
+		return pc == True;
+	}
+
+	template<typename Iterator>
+	bool operator()(Iterator&& it) const {
+		return matches(*it);
+	}
+
+	// Whether the expression was recognised as a plain set of values.
+	bool valueSet() const { return isValueSet; }
+
+	std::size_t instructions() const { return code.size(); }
+
+};
+
+template<typename T>
+struct IsNode<dynamic_sentinel<T>> : std::true_type {};
+
+} // namespace ph
+
+#endif /* DYNAMIC_SENTINEL_HPP_ */
@@ -0,0 +1,208 @@
+#ifndef FLAT_MAP_HPP_
+#define FLAT_MAP_HPP_
+
+// A sorted map keeping its keys and its values in two separate arrays, so
+// that scanning or searching the keys never pulls the values into cache:
+//
+//   ph::flat_map<int, std::string> m;
+//   m[3] = "c";
+//   auto keys = m | ph::adaptor::map_keys;      // Range<const int*, const int*>
+//   auto it = ph::find(keys.begin(), ph::untilValue(7) || keys.end(), 5);
+//
+// The map_keys and map_values projections are plain pointer ranges over the
+// arrays, which compose with sentinels like any other range. Inserting and
+// erasing move the elements behind the position, as with a sorted vector.
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "range.hpp"
+#include "adaptor/map.hpp"
+
+namespace ph {
+
+template<typename Key, typename Value, typename Compare = std::less<Key>>
+class flat_map {
+	std::vector<Key> keys_;
+	std::vector<Value> values_;
+	Compare comp;
+
+	template<typename Map, typename Reference>
+	class basic_iterator {
+		Map* map;
+		std::ptrdiff_t i;
+	public:
+		using value_type = std::pair<Key, Value>;
+		using difference_type = std::ptrdiff_t;
+		using reference = Reference;
+		using pointer = void;
+		using iterator_category = std::random_access_iterator_tag;
+
+		basic_iterator(): map(nullptr), i(0) {}
+		basic_iterator(Map* map, std::ptrdiff_t i): map(map), i(i) {}
+
+		reference operator*() const { return reference(map->keys_[i], map->values_[i]); }
+		reference operator[](difference_type n) const { return *(*this + n); }
+
+		basic_iterator& operator++() { ++i; return *this; }
+		basic_iterator operator++(int) { basic_iterator old = *this; ++i; return old; }
+		basic_iterator& operator--() { --i; return *this; }
+		basic_iterator operator--(int) { basic_iterator old = *this; --i; return old; }
+		basic_iterator& operator+=(difference_type n) { i += n; return *this; }
+		basic_iterator& operator-=(difference_type n) { i -= n; return *this; }
+		basic_iterator operator+(difference_type n) const { return basic_iterator(map, i + n); }
+		basic_iterator operator-(difference_type n) const { return basic_iterator(map, i - n); }
+		difference_type operator-(const basic_iterator& other) const { return i - other.i; }
+
+		bool operator==(const basic_iterator& other) const { return i == other.i; }
+		bool operator!=(const basic_iterator& other) const { return i != other.i; }
+		bool operator<(const basic_iterator& other) const { return i < other.i; }
+		bool operator>(const basic_iterator& other) const { return i > other.i; }
+		bool operator<=(const basic_iterator& other) const { return i <= other.i; }
+		bool operator>=(const basic_iterator& other) const { return i >= other.i; }
+
+		// Position in the key and value arrays.
+		std::size_t index() const { return i; }
+	};
+
+public:
+	using key_type = Key;
+	using mapped_type = Value;
+	using size_type = std::size_t;
+	using iterator = basic_iterator<flat_map, std::pair<const Key&, Value&>>;
+	using const_iterator = basic_iterator<const flat_map, std::pair<const Key&, const Value&>>;
+
+	flat_map() = default;
+	explicit flat_map(const Compare& comp): comp(comp) {}
+
+	flat_map(std::initializer_list<std::pair<Key, Value>> elements, const Compare& comp = Compare()): comp(comp) {
+		reserve(elements.size());
+		for(const auto& element: elements) {
+			insert(element.first, element.second);
+		}
+	}
+
+	size_type size() const { return keys_.size(); }
+	bool empty() const { return keys_.empty(); }
+
+	void reserve(size_type n) {
+		keys_.reserve(n);
+		values_.reserve(n);
+	}
+
+	void clear() {
+		keys_.clear();
+		values_.clear();
+	}
+
+	iterator begin() { return iterator(this, 0); }
+	iterator end() { return iterator(this, size()); }
+	const_iterator begin() const { return const_iterator(this, 0); }
+	const_iterator end() const { return const_iterator(this, size()); }
+
+	// The keys in order, and the values in the order of their keys.
+	Range<const Key*, const Key*> keys() const { return make_iterator_range(keys_.data(), keys_.data() + size()); }
+	Range<Value*, Value*> values() { return make_iterator_range(values_.data(), values_.data() + size()); }
+	Range<const Value*, const Value*> values() const { return make_iterator_range(values_.data(), values_.data() + size()); }
+
+	size_type lower_bound_index(const Key& key) const {
+		return std::lower_bound(keys_.begin(), keys_.end(), key, comp) - keys_.begin();
+	}
+
+	iterator lower_bound(const Key& key) { return iterator(this, lower_bound_index(key)); }
+	const_iterator lower_bound(const Key& key) const { return const_iterator(this, lower_bound_index(key)); }
+
+	iterator find(const Key& key) {
+		const size_type i = lower_bound_index(key);
+		return i < size() && !comp(key, keys_[i]) ? iterator(this, i) : end();
+	}
+
+	const_iterator find(const Key& key) const {
+		const size_type i = lower_bound_index(key);
+		return i < size() && !comp(key, keys_[i]) ? const_iterator(this, i) : end();
+	}
+
+	size_type count(const Key& key) const { return find(key) != end() ? 1 : 0; }
+
+	// Inserts the element unless the key is present; tells where the key is
+	// and whether the element was inserted. If copying the value throws, the
+	// key is taken out again, so the arrays stay the same length.
+	std::pair<iterator, bool> insert(const Key& key, const Value& value) {
+		const size_type i = lower_bound_index(key);
+		if(i < size() && !comp(key, keys_[i])) {
+			return {iterator(this, i), false};
+		}
+		keys_.insert(keys_.begin() + i, key);
+		try {
+			values_.insert(values_.begin() + i, value);
+		} catch(...) {
+			keys_.erase(keys_.begin() + i);
+			throw;
+		}
+		return {iterator(this, i), true};
+	}
+
+	Value& operator[](const Key& key) {
+		return (*insert(key, Value()).first).second;
+	}
+
+	Value& at(const Key& key) {
+		const auto it = find(key);
+		if(it == end()) {
+			throw std::out_of_range("ph::flat_map::at");
+		}
+		return values_[it.index()];
+	}
+
+	const Value& at(const Key& key) const {
+		const auto it = find(key);
+		if(it == end()) {
+			throw std::out_of_range("ph::flat_map::at");
+		}
+		return values_[it.index()];
+	}
+
+	size_type erase(const Key& key) {
+		const auto it = find(key);
+		if(it == end()) {
+			return 0;
+		}
+		keys_.erase(keys_.begin() + it.index());
+		values_.erase(values_.begin() + it.index());
+		return 1;
+	}
+
+};
+
+} // namespace ph
+
+// The projections of a flat_map are its arrays; they point into the map, so
+// it has to outlive them, and a temporary map cannot be projected.
+template<typename Key, typename Value, typename Compare>
+auto operator|(const ph::flat_map<Key, Value, Compare>& m, ph::adaptor::detail::dummy_map_keys_range) {
+	return m.keys();
+}
+
+template<typename Key, typename Value, typename Compare>
+auto operator|(ph::flat_map<Key, Value, Compare>& m, ph::adaptor::detail::dummy_map_values_range) {
+	return m.values();
+}
+
+template<typename Key, typename Value, typename Compare>
+auto operator|(const ph::flat_map<Key, Value, Compare>& m, ph::adaptor::detail::dummy_map_values_range) {
+	return m.values();
+}
+
+template<typename Key, typename Value, typename Compare>
+void operator|(ph::flat_map<Key, Value, Compare>&&, ph::adaptor::detail::dummy_map_keys_range) = delete;
+
+template<typename Key, typename Value, typename Compare>
+void operator|(ph::flat_map<Key, Value, Compare>&&, ph::adaptor::detail::dummy_map_values_range) = delete;
+
+#endif /* FLAT_MAP_HPP_ */
@@ -0,0 +1,136 @@
+#ifndef GENERATOR_HPP_
+#define GENERATOR_HPP_
+
+// A source of values produced on demand, usable as a Begin for the ph::
+// algorithms and adaptors without materialising the values first.
+//
+// The producer is a resumable function object: every call either writes the
+// next value into its argument and returns true, or returns false once it is
+// exhausted. Its state lives inside the generator, so walking a generator
+// allocates nothing.
+//
+//   int i = 0;
+//   auto g = ph::make_generator<int>([&i](int& out) { out = i++; return i <= 100; });
+//   auto pos = ph::find(g.begin(), ph::untilValue(50) || g.end(), 42);
+//   auto odd = g | ph::adaptor::filtered([](int i) { return i % 2; });
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "ph.hpp"
+
+namespace ph {
+
+template<typename T, typename Producer>
+class generator;
+
+namespace detail {
+
+// Single pass: all iterators of a generator share its current value.
+template<typename T, typename Producer>
+class GeneratorIterator {
+	generator<T, Producer>* g;
+public:
+	using value_type = T;
+	using difference_type = std::ptrdiff_t;
+	using reference = const T&;
+	using pointer = const T*;
+	using iterator_category = std::input_iterator_tag;
+
+	GeneratorIterator(): g(nullptr) {}
+	explicit GeneratorIterator(generator<T, Producer>& g): g(&g) {}
+
+	GeneratorIterator& operator++() {
+		g->advance();
+		return *this;
+	}
+
+	const T& operator*() const { return g->current; }
+	const T* operator->() const { return &g->current; }
+
+	bool done() const { return g->finished; }
+
+	// Number of values consumed so far, which lets counted() bound a
+	// generator without copying its iterators.
+	std::ptrdiff_t index() const { return g->consumed; }
+
+	friend bool operator==(const GeneratorIterator& lhs, const GeneratorIterator& rhs) {
+		return lhs.g == rhs.g;
+	}
+	friend bool operator!=(const GeneratorIterator& lhs, const GeneratorIterator& rhs) {
+		return !(lhs == rhs);
+	}
+};
+
+} // namespace detail
+
+// Compares equal to the iterators of an exhausted generator. It is not a
+// node itself, but like a plain end iterator it composes with them, as in
+// ph::untilValue(0) || g.end().
+struct GeneratorEnd {};
+
+template<typename T, typename Producer>
+bool operator==(const detail::GeneratorIterator<T, Producer>& it, GeneratorEnd) { return it.done(); }
+
+template<typename T, typename Producer>
+bool operator==(GeneratorEnd, const detail::GeneratorIterator<T, Producer>& it) { return it.done(); }
+
+template<typename T, typename Producer>
+bool operator!=(const detail::GeneratorIterator<T, Producer>& it, GeneratorEnd) { return !it.done(); }
+
+template<typename T, typename Producer>
+bool operator!=(GeneratorEnd, const detail::GeneratorIterator<T, Producer>& it) { return !it.done(); }
+
+template<typename T, typename Producer>
+class generator {
+	friend class detail::GeneratorIterator<T, Producer>;
+
+	Producer producer;
+	T current;
+	std::ptrdiff_t consumed = -1;
+	bool finished = false;
+
+	void advance() {
+		if(!finished) {
+			finished = !producer(current);
+			++consumed;
+		}
+	}
+
+public:
+	using iterator = detail::GeneratorIterator<T, Producer>;
+
+	explicit generator(Producer producer): producer(std::move(producer)), current() {}
+
+	generator(const generator&) = delete;
+	generator& operator=(const generator&) = delete;
+	generator(generator&&) = default;
+
+	// The first call produces the first value.
+	iterator begin() {
+		if(consumed < 0) {
+			advance();
+		}
+		return iterator(*this);
+	}
+
+	GeneratorEnd end() const { return {}; }
+
+};
+
+template<typename T, typename Producer>
+generator<T, typename std::decay<Producer>::type> make_generator(Producer&& producer) {
+	return generator<T, typename std::decay<Producer>::type>(std::forward<Producer>(producer));
+}
+
+// Adaptors are piped from a generator by reference, as in g | filtered(p),
+// and hold iterators into it, so it has to outlive them. Piping a temporary
+// generator would leave them dangling.
+template<typename T, typename Producer, typename Adaptor>
+void operator|(generator<T, Producer>&&, Adaptor) = delete;
+
+} // namespace ph
+
+#endif /* GENERATOR_HPP_ */
@@ -0,0 +1,227 @@
+#ifndef INTERRUPT_HPP_
+#define INTERRUPT_HPP_
+
+// Sentinels for scans that must give up on an external condition, a
+// cancellation request or a deadline, without paying for checking it on
+// every element:
+//
+//   auto stop = ph::until_deadline(start + std::chrono::milliseconds(5));
+//   auto it = ph::find(v.begin(), v.end() || stop, 42);
+//   if(stop.cut_off()) { ... it is where the scan gave up ... }
+//
+// The condition is only checked every block of elements. The block size
+// adapts to the time the elements take, aiming at one check per granularity
+// (20us by default), so the checks cost the same whatever an element costs.
+//
+// ph::find, find_if, count, count_if and for_each with an end of the form
+// bound || interrupt run the block as a loop over the bound alone and check
+// the condition between blocks. Anywhere else the node counts the elements
+// down itself, which is still correct, only slower.
+//
+// Copies share the state, so the node passed to an algorithm tells whether
+// the scan was cut off.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+#include "ph.hpp"
+#include "algorithm.hpp"
+
+namespace ph {
+
+namespace detail {
+
+// Anything with a stop_requested(), like std::stop_token. Such tokens are
+// handles to a shared state and are kept by value, so a temporary one, as
+// from source.get_token(), may be passed.
+template<typename Token>
+struct CancelCondition {
+	using clock = std::chrono::steady_clock;
+
+	Token token;
+
+	explicit CancelCondition(const Token& token): token(token) {}
+
+	bool operator()(clock::time_point) const {
+		return token.stop_requested();
+	}
+};
+
+// An std::atomic<bool> is referred to, and has to outlive the scan.
+template<>
+struct CancelCondition<std::atomic<bool>> {
+	using clock = std::chrono::steady_clock;
+
+	const std::atomic<bool>* token;
+
+	explicit CancelCondition(const std::atomic<bool>& token): token(&token) {}
+
+	bool operator()(clock::time_point) const {
+		return token->load(std::memory_order_relaxed);
+	}
+};
+
+template<typename Clock, typename Duration>
+struct DeadlineCondition {
+	using clock = Clock;
+
+	std::chrono::time_point<Clock, Duration> deadline;
+
+	bool operator()(typename clock::time_point now) const {
+		return now >= deadline;
+	}
+};
+
+} // namespace detail
+
+template<typename Condition>
+class InterruptNode {
+	using clock = typename Condition::clock;
+
+	struct State {
+		Condition condition;
+		std::chrono::nanoseconds granularity;
+		std::ptrdiff_t block = 256;
+		std::ptrdiff_t countdown = 256;
+		typename clock::time_point lastCheck = clock::now();
+		bool cutOff = false;
+
+		State(const Condition& condition, std::chrono::nanoseconds granularity):
+			condition(condition), granularity(granularity) {}
+	};
+
+	std::shared_ptr<State> state;
+
+public:
+	InterruptNode(const Condition& condition, std::chrono::nanoseconds granularity):
+		state(std::make_shared<State>(condition, granularity)) {}
+
+	// Elements to process before the next check.
+	std::ptrdiff_t blockSize() const { return state->block; }
+
+	// Checks the condition after elements more elements, and resizes the
+	// block to the time they took. Once cut off the node stays so.
+	bool check(std::ptrdiff_t elements) const {
+		State& s = *state;
+		const auto now = clock::now();
+		const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(now - s.lastCheck).count();
+		s.lastCheck = now;
+		const double perElement = static_cast<double>(std::max<decltype(elapsed)>(elapsed, 1)) / std::max<std::ptrdiff_t>(elements, 1);
+		s.block = static_cast<std::ptrdiff_t>(std::min(std::max(s.granularity.count() / perElement, 16.0), 16777216.0));
+		s.countdown = s.block;
+		s.cutOff = s.cutOff || s.condition(now);
+		return s.cutOff;
+	}
+
+	template<typename Iterator>
+	bool operator()(Iterator&&) const {
+		if(--state->countdown > 0) {
+			return false;
+		}
+		return check(state->block);
+	}
+
+	bool cut_off() const { return state->cutOff; }
+
+};
+
+template<typename Condition>
+struct IsNode<InterruptNode<Condition>> : std::true_type {};
+
+template<typename Token>
+InterruptNode<detail::CancelCondition<Token>> until_cancelled(const Token& token,
+		std::chrono::nanoseconds granularity = std::chrono::microseconds(20)) {
+	return InterruptNode<detail::CancelCondition<Token>>(detail::CancelCondition<Token>(token), granularity);
+}
+
+InterruptNode<detail::CancelCondition<std::atomic<bool>>> until_cancelled(const std::atomic<bool>&& token,
+		std::chrono::nanoseconds granularity = std::chrono::microseconds(20)) = delete;
+
+template<typename Clock, typename Duration>
+InterruptNode<detail::DeadlineCondition<Clock, Duration>> until_deadline(const std::chrono::time_point<Clock, Duration>& deadline,
+		std::chrono::nanoseconds granularity = std::chrono::microseconds(20)) {
+	return InterruptNode<detail::DeadlineCondition<Clock, Duration>>(detail::DeadlineCondition<Clock, Duration>{deadline}, granularity);
+}
+
+namespace detail {
+
+// Hands body blocks of at most blockSize elements of [begin, bound), checking
+// the interrupt in between. body(begin, n) advances begin by up to n elements
+// and returns false if it stopped early, because it is done or reached bound.
+// A scan that ends with a block is not checked, so it is never cut off.
+template<typename Begin, typename Bound, typename Condition, typename Body>
+Begin blocked(Begin begin, const Bound& bound, const InterruptNode<Condition>& interrupt, Body body) {
+	for(;;) {
+		const std::ptrdiff_t n = interrupt.blockSize();
+		if(!body(begin, n) || !(begin != bound) || interrupt.check(n)) {
+			return begin;
+		}
+	}
+}
+
+} // namespace detail
+
+template<typename Begin, typename Bound, typename Condition, typename UnaryPredicate>
+Begin find_if(Begin begin, const OrNode<Bound, InterruptNode<Condition>>& end, UnaryPredicate p) {
+	const auto bound = ph::anchor(begin, end.leftNode);
+	return detail::blocked(begin, bound, end.rightNode, [&](Begin& it, std::ptrdiff_t n) {
+		for(; n && it != bound; --n, ++it) {
+			if(p(*it)) {
+				return false;
+			}
+		}
+		return n == 0;
+	});
+}
+
+template<typename Begin, typename Bound, typename Condition, typename UnaryPredicate>
+typename std::iterator_traits<Begin>::difference_type count_if(Begin begin,
+		const OrNode<Bound, InterruptNode<Condition>>& end, UnaryPredicate p) {
+	const auto bound = ph::anchor(begin, end.leftNode);
+	typename std::iterator_traits<Begin>::difference_type ret = 0;
+	detail::blocked(begin, bound, end.rightNode, [&](Begin& it, std::ptrdiff_t n) {
+		for(; n && it != bound; --n, ++it) {
+			if(p(*it)) {
+				++ret;
+			}
+		}
+		return n == 0;
+	});
+	return ret;
+}
+
+template<typename Begin, typename Bound, typename Condition, typename T>
+typename std::iterator_traits<Begin>::difference_type count(Begin begin,
+		const OrNode<Bound, InterruptNode<Condition>>& end, const T& value) {
+	return ph::count_if(begin, end, [&value](const typename std::iterator_traits<Begin>::value_type& v) {
+		return v == value;
+	});
+}
+
+template<typename Begin, typename Bound, typename Condition, typename UnaryFunction>
+UnaryFunction for_each(Begin begin, const OrNode<Bound, InterruptNode<Condition>>& end, UnaryFunction f) {
+	const auto bound = ph::anchor(begin, end.leftNode);
+	detail::blocked(begin, bound, end.rightNode, [&](Begin& it, std::ptrdiff_t n) {
+		for(; n && it != bound; --n, ++it) {
+			f(*it);
+		}
+		return n == 0;
+	});
+	return f;
+}
+
+template<typename Begin, typename Bound, typename Condition, typename ValueType>
+Begin find(Begin begin, const OrNode<Bound, InterruptNode<Condition>>& end, const ValueType& value) {
+	return ph::find_if(begin, end, [&value](const typename std::iterator_traits<Begin>::value_type& v) {
+		return v == value;
+	});
+}
+
+} // namespace ph
+
+#endif /* INTERRUPT_HPP_ */
@@ -0,0 +1,199 @@
+#ifndef NUMERIC_HPP_
+#define NUMERIC_HPP_
+
+// The below algorithms are ports from
+// http://en.cppreference.com/w/cpp/header/numeric
+//
+// As in algorithm.hpp, begin and end may be of different types. reduce and
+// transform_reduce are the C++17 ones: they may combine the elements in any
+// order, so the operation has to be associative and commutative, while
+// accumulate keeps folding strictly from left to right.
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <type_traits>
+
+#include "ph.hpp"
+#include "range.hpp"
+#include "algorithm.hpp"
+
+namespace ph {
+
+template<typename Iterator, typename T>
+T accumulate(Iterator begin, Iterator end, T init) {
+	return std::accumulate(begin, end, init);
+}
+
+template<typename Begin, typename End, typename T>
+T accumulate(Begin begin, End end, T init) {
+	auto stop = ph::anchor(begin, end);
+	for(; begin != stop; ++begin) {
+		init = init + *begin;
+	}
+	return init;
+}
+
+template<typename Iterator, typename T, typename BinaryOperation>
+T accumulate(Iterator begin, Iterator end, T init, BinaryOperation op) {
+	return std::accumulate(begin, end, init, op);
+}
+
+template<typename Begin, typename End, typename T, typename BinaryOperation>
+T accumulate(Begin begin, End end, T init, BinaryOperation op) {
+	auto stop = ph::anchor(begin, end);
+	for(; begin != stop; ++begin) {
+		init = op(init, *begin);
+	}
+	return init;
+}
+
+namespace detail {
+
+struct Identity {
+	template<typename T>
+	T&& operator()(T&& t) const { return std::forward<T>(t); }
+};
+
+// Independent accumulators, one per lane, so that consecutive elements do
+// not wait on each other; with arithmetic types the compiler keeps them in
+// vector registers. The lanes start from the first elements they see, so
+// the operation needs no identity element.
+template<typename T>
+struct Lanes {
+	static constexpr std::ptrdiff_t count = 16;
+	static constexpr std::ptrdiff_t block = 16 * count;
+
+	T acc[count];
+	bool started = false;
+
+	// Folds element(0) ... element(block - 1) into the lanes.
+	template<typename BinaryOperation, typename Element>
+	void add(BinaryOperation& op, Element element) {
+		std::ptrdiff_t i = 0;
+		if(!started) {
+			for(std::ptrdiff_t j = 0; j < count; ++j) {
+				acc[j] = element(j);
+			}
+			started = true;
+			i = count;
+		}
+		for(; i < block; i += count) {
+			for(std::ptrdiff_t j = 0; j < count; ++j) {
+				acc[j] = op(acc[j], element(i + j));
+			}
+		}
+	}
+
+	// Combines the lanes pairwise, then with init.
+	template<typename BinaryOperation>
+	T finish(T init, BinaryOperation& op) {
+		if(!started) {
+			return init;
+		}
+		for(std::ptrdiff_t width = count / 2; width; width /= 2) {
+			for(std::ptrdiff_t j = 0; j < width; ++j) {
+				acc[j] = op(acc[j], acc[j + width]);
+			}
+		}
+		return op(init, acc[0]);
+	}
+};
+
+// Contiguous arithmetic data is reduced a block at a time, with the end
+// checked for the block before the lanes fold it.
+template<typename Begin, typename End, typename T, typename BinaryOperation, typename Element>
+T reduceLanes(Begin begin, const End& end, T init, BinaryOperation op, Element element) {
+	auto stop = ph::anchor(begin, end);
+	using Positional = std::integral_constant<bool, PositionOf<Begin, decltype(stop)>::value>;
+	Lanes<T> lanes;
+	std::ptrdiff_t offset = 0;
+	for(;;) {
+		const std::ptrdiff_t n = available(begin + offset, stop, Lanes<T>::block, Positional{});
+		if(n < Lanes<T>::block) {
+			for(std::ptrdiff_t i = 0; i < n; ++i) {
+				init = op(init, element(offset + i));
+			}
+			return lanes.finish(init, op);
+		}
+		lanes.add(op, [&element, offset](std::ptrdiff_t i) { return element(offset + i); });
+		offset += n;
+	}
+}
+
+template<typename Begin, typename T, typename = void>
+struct IsLaneReducible : std::false_type {};
+
+template<typename U, typename T>
+struct IsLaneReducible<U*, T, typename std::enable_if<std::is_arithmetic<T>::value>::type> : std::true_type {};
+
+template<typename Begin, typename End, typename T, typename BinaryOperation, typename UnaryOperation>
+T transform_reduce(Begin begin, End end, T init, BinaryOperation reduce, UnaryOperation transform, std::true_type) {
+	return reduceLanes(begin, end, init, reduce, [begin, &transform](std::ptrdiff_t i) -> T {
+		return transform(begin[i]);
+	});
+}
+
+template<typename Begin, typename End, typename T, typename BinaryOperation, typename UnaryOperation>
+T transform_reduce(Begin begin, End end, T init, BinaryOperation reduce, UnaryOperation transform, std::false_type) {
+	auto stop = ph::anchor(begin, end);
+	for(; begin != stop; ++begin) {
+		init = reduce(init, transform(*begin));
+	}
+	return init;
+}
+
+template<typename Begin1, typename End1, typename Begin2, typename T, typename BinaryOperation1, typename BinaryOperation2>
+T transform_reduce(Begin1 begin1, End1 end1, Begin2 begin2, T init, BinaryOperation1 reduce, BinaryOperation2 transform, std::true_type) {
+	return reduceLanes(begin1, end1, init, reduce, [begin1, begin2, &transform](std::ptrdiff_t i) -> T {
+		return transform(begin1[i], begin2[i]);
+	});
+}
+
+template<typename Begin1, typename End1, typename Begin2, typename T, typename BinaryOperation1, typename BinaryOperation2>
+T transform_reduce(Begin1 begin1, End1 end1, Begin2 begin2, T init, BinaryOperation1 reduce, BinaryOperation2 transform, std::false_type) {
+	auto stop = ph::anchor(begin1, end1);
+	for(; begin1 != stop; ++begin1, ++begin2) {
+		init = reduce(init, transform(*begin1, *begin2));
+	}
+	return init;
+}
+
+} // namespace detail
+
+template<typename Begin, typename End, typename T, typename BinaryOperation, typename UnaryOperation>
+T transform_reduce(Begin begin, End end, T init, BinaryOperation reduce, UnaryOperation transform) {
+	return detail::transform_reduce(begin, end, init, reduce, transform,
+			std::integral_constant<bool, detail::IsLaneReducible<Begin, T>::value>{});
+}
+
+template<typename Begin1, typename End1, typename Begin2, typename T, typename BinaryOperation1, typename BinaryOperation2>
+T transform_reduce(Begin1 begin1, End1 end1, Begin2 begin2, T init, BinaryOperation1 reduce, BinaryOperation2 transform) {
+	return detail::transform_reduce(begin1, end1, begin2, init, reduce, transform,
+			std::integral_constant<bool, detail::IsLaneReducible<Begin1, T>::value && std::is_pointer<Begin2>::value>{});
+}
+
+template<typename Begin1, typename End1, typename Begin2, typename T>
+T transform_reduce(Begin1 begin1, End1 end1, Begin2 begin2, T init) {
+	return ph::transform_reduce(begin1, end1, begin2, init, std::plus<>(), std::multiplies<>());
+}
+
+template<typename Begin, typename End, typename T, typename BinaryOperation>
+T reduce(Begin begin, End end, T init, BinaryOperation op) {
+	return ph::transform_reduce(begin, end, init, op, detail::Identity());
+}
+
+template<typename Begin, typename End, typename T>
+T reduce(Begin begin, End end, T init) {
+	return ph::reduce(begin, end, init, std::plus<>());
+}
+
+template<typename Begin, typename End>
+typename std::iterator_traits<Begin>::value_type reduce(Begin begin, End end) {
+	return ph::reduce(begin, end, typename std::iterator_traits<Begin>::value_type{});
+}
+
+} // namespace ph
+
+#endif /* NUMERIC_HPP_ */
@@ -0,0 +1,132 @@
+#ifndef PARALLEL_HPP_
+#define PARALLEL_HPP_
+
+// Multi threaded variants of the algorithms, for large contiguous buffers.
+//
+// The stop conditions used here have to be answerable by looking at a single
+// position, like untilValue, since every thread starts its scan in the middle
+// of the buffer.
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <vector>
+
+#include "ph.hpp"
+#include "range.hpp"
+#include "numeric.hpp"
+
+namespace ph {
+
+namespace detail {
+
+template<typename Delimiter>
+std::vector<const char*> findDelimiters(const char* begin, const char* end, const Delimiter& d) {
+	std::vector<const char*> found;
+	for(;;) {
+		begin = ph::next(begin, end || d);
+		if(begin == end) {
+			return found;
+		}
+		found.push_back(begin++);
+	}
+}
+
+} // namespace detail
+
+// Calls f with every record of [begin, end), in order. Records are the same
+// as the fields produced by ph::adaptor::split(d).
+//
+// The buffer is cut into one chunk per thread, each chunk only collects the
+// positions of its delimiters, and the records are stitched together from
+// those positions. Records straddling a chunk boundary need no special care,
+// because a record always runs from one delimiter to the next one.
+template<typename Delimiter, typename RecordFunction>
+RecordFunction parallel_split(const char* begin, const char* end, Delimiter d,
+		unsigned threads, RecordFunction f) {
+	threads = std::max(threads, 1u);
+	const std::size_t chunkSize = (end - begin + threads - 1) / threads;
+
+	auto chunkEnd = [&](unsigned chunk) {
+		return begin + std::min<std::size_t>((chunk + 1) * chunkSize, end - begin);
+	};
+
+	std::vector<std::future<std::vector<const char*>>> chunks;
+	for(unsigned chunk = 1; chunk < threads; ++chunk) {
+		const char* b = begin + std::min<std::size_t>(chunk * chunkSize, end - begin);
+		const char* e = chunkEnd(chunk);
+		chunks.push_back(std::async(std::launch::async, [b, e, &d]() {
+			return detail::findDelimiters(b, e, d);
+		}));
+	}
+
+	const char* recordBegin = begin;
+	auto emit = [&](const std::vector<const char*>& delimiters) {
+		for(const char* delimiter: delimiters) {
+			f(make_iterator_range(recordBegin, delimiter));
+			recordBegin = delimiter + 1;
+		}
+	};
+
+	emit(detail::findDelimiters(begin, chunkEnd(0), d));
+	for(auto& chunk: chunks) {
+		emit(chunk.get());
+	}
+	f(make_iterator_range(recordBegin, end));
+
+	return f;
+}
+
+// Returns an ordered index of the records of [begin, end).
+template<typename Delimiter>
+std::vector<Range<const char*, const char*>> parallel_split(const char* begin, const char* end,
+		Delimiter d, unsigned threads) {
+	std::vector<Range<const char*, const char*>> records;
+	parallel_split(begin, end, d, threads, [&records](const Range<const char*, const char*>& r) {
+		records.push_back(r);
+	});
+	return records;
+}
+
+// Reduces [begin, end) like ph::reduce, with one chunk per thread.
+//
+// The end is found first, so any stop condition works here, then every chunk
+// is reduced on its own, starting from its first element, and the partial
+// results are combined pairwise, neighbours first.
+template<typename T, typename End, typename U, typename BinaryOperation>
+U parallel_reduce(const T* begin, End end, U init, BinaryOperation op, unsigned threads) {
+	const T* last = ph::next(begin, end);
+	const std::size_t size = last - begin;
+	threads = static_cast<unsigned>(std::max<std::size_t>(std::min<std::size_t>(threads, size), 1));
+	const std::size_t chunkSize = (size + threads - 1) / threads;
+
+	std::vector<std::future<U>> chunks;
+	for(std::size_t from = 0; from < size; from += chunkSize) {
+		const T* b = begin + from;
+		const T* e = begin + std::min(from + chunkSize, size);
+		chunks.push_back(std::async(from ? std::launch::async : std::launch::deferred, [b, e, &op]() {
+			return ph::reduce(b + 1, e, static_cast<U>(*b), op);
+		}));
+	}
+
+	std::vector<U> partials;
+	for(auto& chunk: chunks) {
+		partials.push_back(chunk.get());
+	}
+	for(std::size_t width = 1; width < partials.size(); width *= 2) {
+		for(std::size_t i = 0; i + width < partials.size(); i += 2 * width) {
+			partials[i] = op(partials[i], partials[i + width]);
+		}
+	}
+	return partials.empty() ? init : op(init, partials.front());
+}
+
+template<typename T, typename End, typename U>
+U parallel_reduce(const T* begin, End end, U init, unsigned threads) {
+	return parallel_reduce(begin, end, init, std::plus<>(), threads);
+}
+
+} // namespace ph
+
+#endif /* PARALLEL_HPP_ */
@@ -1,6 +1,8 @@
 #ifndef PH_HPP_
 #define PH_HPP_
 
+#include <cstddef>
+#include <iterator>
 #include <utility>
 #include <type_traits>
 #include <boost/type_traits/has_equal_to.hpp>
@@ -72,6 +74,60 @@ struct NotNode {
 	OperandNode operandNode;
 };
 
+// A leaf that stops on a single value. Unlike a LeafNode around a lambda the
+// value stays visible in the type, so algorithms can recognise trees built
+// purely from values and search for them in bulk.
+template<typename Value>
+struct ValueNode {
+
+	ValueNode(const Value& value) : value(value) {}
+
+	template<typename Iterator>
+	bool operator()(Iterator&& it) const {
+		const Value& v = *it;
+		return v == value;
+	}
+
+	Value value;
+};
+
+// Stops after a fixed number of elements. The count starts wherever the
+// algorithm using it starts, so it has to be anchored to that position with
+// anchor() before it can be evaluated.
+struct CountedNode {
+
+	CountedNode(std::ptrdiff_t n) : n(n) {}
+
+	template<typename Iterator>
+	bool operator()(Iterator&&) const {
+		static_assert(sizeof(Iterator) == 0, "counted() must be anchored to a begin iterator first");
+		return true;
+	}
+
+	std::ptrdiff_t n;
+};
+
+// What a CountedNode becomes for iterators that cannot jump: a counter that
+// is decremented for every step its position is moved towards the evaluated
+// iterator. Repeated evaluations at the same position are therefore free, and
+// positions skipped by short-circuiting are still counted.
+template<typename Begin>
+struct CounterNode {
+
+	CounterNode(const Begin& position, std::ptrdiff_t remaining) : position(position), remaining(remaining) {}
+
+	template<typename Iterator>
+	bool operator()(Iterator&& it) const {
+		for(; !(position == it); ++position) {
+			--remaining;
+		}
+		return remaining <= 0;
+	}
+
+	mutable Begin position;
+	mutable std::ptrdiff_t remaining;
+};
+
 template<class T>
 struct IsNode : std::false_type {};
 
@@ -87,6 +143,15 @@ struct IsNode<NotNode<T>> : std::true_type {};
 template<typename T>
 struct IsNode<LeafNode<T>> : std::true_type {};
 
+template<typename T>
+struct IsNode<ValueNode<T>> : std::true_type {};
+
+template<>
+struct IsNode<CountedNode> : std::true_type {};
+
+template<typename T>
+struct IsNode<CounterNode<T>> : std::true_type {};
+
 template<typename It, typename Node>
 typename std::enable_if<IsNode<Node>::value, bool>::type operator==(const Node& node, It&& it) {
 	return node(std::forward<It>(it));
@@ -132,7 +197,7 @@ typename std::enable_if<
 template<typename LeftNode, typename RightNode>
 typename std::enable_if<
 	!IsNode<LeftNode>::value && IsNode<RightNode>::value,
-	OrNode<LeafNode<LeftNode>, LeafNode<RightNode>>>::type operator||(const LeftNode& leftNode, const RightNode& rightNode) {
+	OrNode<LeafNode<LeftNode>, RightNode>>::type operator||(const LeftNode& leftNode, const RightNode& rightNode) {
 	return OrNode<LeafNode<LeftNode>, RightNode>(LeafNode<LeftNode>(leftNode), rightNode);
 }
 
@@ -153,7 +218,7 @@ typename std::enable_if<
 template<typename LeftNode, typename RightNode>
 typename std::enable_if<
 	!IsNode<LeftNode>::value && IsNode<RightNode>::value,
-	AndNode<LeafNode<LeftNode>, LeafNode<RightNode>>>::type operator&&(const LeftNode& leftNode, const RightNode& rightNode) {
+	AndNode<LeafNode<LeftNode>, RightNode>>::type operator&&(const LeftNode& leftNode, const RightNode& rightNode) {
 	return AndNode<LeafNode<LeftNode>, RightNode>(LeafNode<LeftNode>(leftNode), rightNode);
 }
 
@@ -171,8 +236,8 @@ LeafNode<Constraint> until(Constraint&& c) {
 }
 
 template<typename Value>
-auto untilValue(const Value& value) {
-	return until([value](const Value& v) { return v == value; });
+ValueNode<Value> untilValue(const Value& value) {
+	return ValueNode<Value>(value);
 }
 
 template<typename Value, typename... Values>
@@ -180,6 +245,138 @@ auto untilValue(const Value& value, const Values&... values) {
 	return untilValue(value) || untilValue(values...);
 }
 
+// Stops after at most n elements, e.g. untilValue('\n') || counted(4096).
+inline CountedNode counted(std::ptrdiff_t n) {
+	return CountedNode(n);
+}
+
+inline CountedNode until_n(std::ptrdiff_t n) {
+	return counted(n);
+}
+
+namespace detail {
+
+template<typename Iterator, typename = void>
+struct IsRandomAccess : std::false_type {};
+
+template<typename Iterator>
+struct IsRandomAccess<Iterator, typename std::enable_if<std::is_base_of<
+	std::random_access_iterator_tag,
+	typename std::iterator_traits<Iterator>::iterator_category>::value>::type> : std::true_type {};
+
+template<typename Begin, typename End, typename = void>
+struct Anchor {
+	using type = End;
+	static type apply(const Begin&, const End& end) { return end; }
+};
+
+// What a CountedNode becomes for random access iterators: a bound on the
+// distance from the position it was anchored to. It is kept as an offset,
+// since begin + n lies past the data whenever the budget is larger than
+// what is left, as in untilValue('\n') || counted(4096).
+template<typename Begin>
+struct OffsetNode {
+
+	OffsetNode(const Begin& origin, std::ptrdiff_t n) : origin(origin), n(n) {}
+
+	template<typename Iterator>
+	bool operator()(Iterator&& it) const {
+		return it - origin >= n;
+	}
+
+	Begin origin;
+	std::ptrdiff_t n;
+};
+
+template<typename Begin>
+struct Anchor<Begin, CountedNode, typename std::enable_if<IsRandomAccess<Begin>::value>::type> {
+	using type = OffsetNode<Begin>;
+	static type apply(const Begin& begin, const CountedNode& node) { return type(begin, node.n); }
+};
+
+template<typename Iterator, typename = void>
+struct HasIndex : std::false_type {};
+
+template<typename Iterator>
+struct HasIndex<Iterator, decltype(void(std::declval<const Iterator&>().index()))> : std::true_type {};
+
+// Single pass sources cannot have their position copied and stepped by a
+// CounterNode, but they know how many elements they have produced.
+struct IndexNode {
+
+	IndexNode(std::ptrdiff_t bound) : bound(bound) {}
+
+	template<typename Iterator>
+	bool operator()(Iterator&& it) const {
+		return it.index() >= bound;
+	}
+
+	std::ptrdiff_t bound;
+};
+
+template<typename Begin>
+struct Anchor<Begin, CountedNode, typename std::enable_if<!IsRandomAccess<Begin>::value && HasIndex<Begin>::value>::type> {
+	using type = IndexNode;
+	static type apply(const Begin& begin, const CountedNode& node) { return type(begin.index() + node.n); }
+};
+
+template<typename Begin>
+struct Anchor<Begin, CountedNode, typename std::enable_if<!IsRandomAccess<Begin>::value && !HasIndex<Begin>::value>::type> {
+	using type = CounterNode<Begin>;
+	static type apply(const Begin& begin, const CountedNode& node) { return type(begin, node.n); }
+};
+
+template<typename Begin, typename T>
+struct Anchor<Begin, LeafNode<T>, typename std::enable_if<IsNode<T>::value>::type> {
+	using type = LeafNode<typename Anchor<Begin, T>::type>;
+	static type apply(const Begin& begin, const LeafNode<T>& node) {
+		return type(Anchor<Begin, T>::apply(begin, node.constraint));
+	}
+};
+
+template<typename Begin, typename LeftNode, typename RightNode>
+struct Anchor<Begin, OrNode<LeftNode, RightNode>> {
+	using type = OrNode<typename Anchor<Begin, LeftNode>::type, typename Anchor<Begin, RightNode>::type>;
+	static type apply(const Begin& begin, const OrNode<LeftNode, RightNode>& node) {
+		return type(Anchor<Begin, LeftNode>::apply(begin, node.leftNode),
+				Anchor<Begin, RightNode>::apply(begin, node.rightNode));
+	}
+};
+
+template<typename Begin, typename LeftNode, typename RightNode>
+struct Anchor<Begin, AndNode<LeftNode, RightNode>> {
+	using type = AndNode<typename Anchor<Begin, LeftNode>::type, typename Anchor<Begin, RightNode>::type>;
+	static type apply(const Begin& begin, const AndNode<LeftNode, RightNode>& node) {
+		return type(Anchor<Begin, LeftNode>::apply(begin, node.leftNode),
+				Anchor<Begin, RightNode>::apply(begin, node.rightNode));
+	}
+};
+
+template<typename Begin, typename OperandNode>
+struct Anchor<Begin, NotNode<OperandNode>> {
+	using type = NotNode<typename Anchor<Begin, OperandNode>::type>;
+	static type apply(const Begin& begin, const NotNode<OperandNode>& node) {
+		return type(Anchor<Begin, OperandNode>::apply(begin, node.operandNode));
+	}
+};
+
+} // namespace detail
+
+template<>
+struct IsNode<detail::IndexNode> : std::true_type {};
+
+template<typename T>
+struct IsNode<detail::OffsetNode<T>> : std::true_type {};
+
+// Binds the position dependent nodes of end (counted) to begin. For random
+// access iterators counted(n) becomes a bound on the offset from begin, for
+// single pass sources with an index() a bound on that index, otherwise a
+// decrementing counter. Trees without such nodes are returned unchanged.
+template<typename Begin, typename End>
+typename detail::Anchor<Begin, End>::type anchor(const Begin& begin, const End& end) {
+	return detail::Anchor<Begin, End>::apply(begin, end);
+}
+
 } // namespace ph
 
 
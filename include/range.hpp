@@ -2,6 +2,9 @@
 #define RANGE_HPP_
 #include <utility>
 #include <iterator>
+#include <type_traits>
+
+#include "simd.hpp"
 
 namespace ph {
 
@@ -32,7 +35,8 @@ template<typename Begin, typename End>
 auto distance(Begin begin, End end) {
 	typename std::iterator_traits<Begin>::difference_type answer = 0;
 
-	for(; begin != end; ++begin) {
+	auto stop = ph::anchor(begin, end);
+	for(; begin != stop; ++begin) {
 		++answer;
 	}
 	return answer;
@@ -44,6 +48,35 @@ auto distance(Range r) {
 	return distance(r.begin(), r.end());
 }
 
+namespace detail {
+
+template<typename Begin>
+struct IsCharPointer : std::integral_constant<bool,
+	std::is_same<Begin, const char*>::value || std::is_same<Begin, char*>::value> {};
+
+template<typename Begin, typename End>
+Begin next(Begin begin, End end, std::false_type) {
+	for(; begin != end; ++begin) {}
+	return begin;
+}
+
+template<typename Begin, typename End>
+Begin next(Begin begin, End end, std::true_type) {
+	return begin + (simd::findAny(begin, makeCharSet(end)) - begin);
+}
+
+} // namespace detail
+
+// Advances begin until it compares equal to end, like std::ranges::next.
+// Char pointers delimited by values, NUL or pointer bounds (including
+// counted() budgets) are scanned with the kernels in simd.hpp.
+template<typename Begin, typename End>
+Begin next(Begin begin, End end) {
+	auto stop = ph::anchor(begin, end);
+	return detail::next(begin, stop, std::integral_constant<bool,
+		detail::IsCharPointer<Begin>::value && detail::CharScan<decltype(stop)>::value>{});
+}
+
 } // namespace ph
 
 #endif /* RANGE_HPP_ */
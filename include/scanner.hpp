@@ -0,0 +1,112 @@
+#ifndef SCANNER_HPP_
+#define SCANNER_HPP_
+
+// Scanning for a sentinel in input that arrives in fragments, e.g. from a
+// socket, without rescanning the fragments already seen.
+//
+//   ph::scanner<ph::SubstringNode> headers(ph::untilSubstring("\r\n\r\n"));
+//   while(!headers.found() && (n = read(fd, buffer, sizeof(buffer))) > 0) {
+//       auto r = headers.next(buffer, buffer + n);
+//       ...
+//   }
+//
+// The scanner is the cursor between fragments: the number of positions
+// consumed so far, and through the sentinel, which it keeps for the whole
+// scan, whatever partial state a stateful sentinel such as untilSubstring
+// carries over. Every position is looked at exactly once, so the cost of a
+// scan does not depend on how the input was cut up.
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "ph.hpp"
+#include "range.hpp"
+
+namespace ph {
+
+template<typename Begin>
+struct ScanResult {
+	// Where the sentinel fired, or the end of the fragment. A match ending
+	// with the fragment is found at its end.
+	Begin position;
+	bool found;
+};
+
+namespace detail {
+
+template<typename Begin, typename Stop>
+Begin scan(Begin begin, const Stop& stop, std::ptrdiff_t& consumed, std::random_access_iterator_tag) {
+	const Begin position = ph::next(begin, stop);
+	consumed += position - begin;
+	return position;
+}
+
+template<typename Begin, typename Stop, typename Category>
+Begin scan(Begin begin, const Stop& stop, std::ptrdiff_t& consumed, Category) {
+	for(; begin != stop; ++begin) {
+		++consumed;
+	}
+	return begin;
+}
+
+// Sentinels like untilSubstring fire on the position after a match, which
+// lies past a fragment the match ends with; they tell through matched().
+template<typename Sentinel>
+auto completed(const Sentinel& stop, int) -> decltype(bool(stop.matched())) {
+	return stop.matched();
+}
+
+template<typename Sentinel>
+bool completed(const Sentinel&, long) {
+	return false;
+}
+
+} // namespace detail
+
+template<typename Sentinel>
+class scanner {
+	static_assert(IsNode<Sentinel>::value, "the sentinel of a scanner must be a node");
+
+	Sentinel stop;
+	std::ptrdiff_t consumed = 0;
+	bool isFound = false;
+
+public:
+	explicit scanner(Sentinel stop): stop(std::move(stop)) {}
+
+	// Continues the scan in the next fragment [begin, end). Once the
+	// sentinel fired, further fragments are not looked at.
+	template<typename Begin, typename End>
+	ScanResult<Begin> next(Begin begin, End end) {
+		if(isFound) {
+			return {begin, true};
+		}
+		// The end of the fragment comes first, so that a stateful sentinel
+		// is never fed the position past the fragment.
+		auto bound = ph::anchor(begin, end);
+		const Begin position = detail::scan(begin, bound || stop, consumed,
+				typename std::iterator_traits<Begin>::iterator_category{});
+		isFound = !(position == bound) || detail::completed(stop, 0);
+		return {position, isFound};
+	}
+
+	bool found() const { return isFound; }
+
+	// Positions consumed over all fragments, up to where the sentinel fired
+	// once it did.
+	std::ptrdiff_t offset() const { return consumed; }
+
+	const Sentinel& sentinel() const { return stop; }
+
+};
+
+template<typename Sentinel>
+scanner<Sentinel> make_scanner(Sentinel stop) {
+	return scanner<Sentinel>(std::move(stop));
+}
+
+} // namespace ph
+
+#endif /* SCANNER_HPP_ */
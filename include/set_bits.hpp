@@ -0,0 +1,144 @@
+#ifndef SET_BITS_HPP_
+#define SET_BITS_HPP_
+
+// The positions of the set bits of a bitset stored as 64 bit words, bit i of
+// the set being bit i % 64 of word i / 64, usable as a Begin for the ph::
+// algorithms and adaptors without building an index vector first:
+//
+//   std::vector<std::uint64_t> mask = ...;
+//   auto selected = ph::set_bits(mask);
+//   ph::for_each(selected.begin(), ph::until([n](std::size_t i) { return i >= n; }) || selected.end(), f);
+//
+// Every step clears the lowest set bit of the current word and counts its
+// trailing zeros, which compile to blsr and tzcnt where BMI is enabled. Runs
+// of zero words are skipped by simd::firstNonZero.
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include "ph.hpp"
+#include "simd.hpp"
+
+namespace ph {
+
+namespace detail {
+
+class SetBitsIterator {
+	const std::uint64_t* first;
+	const std::uint64_t* word;
+	const std::uint64_t* last;
+	std::uint64_t bits;
+	std::ptrdiff_t visited;
+
+	void settle() {
+		word = simd::firstNonZero(word, last);
+		bits = word != last ? *word : 0;
+	}
+
+public:
+	using value_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using reference = std::size_t;
+	using pointer = void;
+	using iterator_category = std::forward_iterator_tag;
+
+	SetBitsIterator(): first(nullptr), word(nullptr), last(nullptr), bits(0), visited(0) {}
+
+	SetBitsIterator(const std::uint64_t* first, const std::uint64_t* last):
+		first(first), word(first), last(last), bits(0), visited(0)
+	{
+		settle();
+	}
+
+	SetBitsIterator& operator++() {
+		bits &= bits - 1;
+		if(!bits) {
+			++word;
+			settle();
+		}
+		++visited;
+		return *this;
+	}
+
+	SetBitsIterator operator++(int) {
+		SetBitsIterator old = *this;
+		++*this;
+		return old;
+	}
+
+	// The position of the bit; at the end, the number of bits in the words,
+	// so trees on the position may be evaluated before the end is checked.
+	std::size_t operator*() const {
+		return static_cast<std::size_t>(word - first) * 64 + (bits ? __builtin_ctzll(bits) : 0);
+	}
+
+	bool done() const { return word == last; }
+
+	// Number of set bits walked so far, which lets counted() bound the walk
+	// without stepping a copy of the iterator.
+	std::ptrdiff_t index() const { return visited; }
+
+	// The words from the current one on, the current one holding only the
+	// bits not walked yet.
+	const std::uint64_t* currentWord() const { return word; }
+	const std::uint64_t* lastWord() const { return last; }
+	std::uint64_t remainingBits() const { return bits; }
+
+	friend bool operator==(const SetBitsIterator& lhs, const SetBitsIterator& rhs) {
+		return lhs.word == rhs.word && lhs.bits == rhs.bits;
+	}
+	friend bool operator!=(const SetBitsIterator& lhs, const SetBitsIterator& rhs) {
+		return !(lhs == rhs);
+	}
+};
+
+} // namespace detail
+
+struct SetBitsEnd {};
+
+inline bool operator==(const detail::SetBitsIterator& it, SetBitsEnd) { return it.done(); }
+inline bool operator==(SetBitsEnd, const detail::SetBitsIterator& it) { return it.done(); }
+inline bool operator!=(const detail::SetBitsIterator& it, SetBitsEnd) { return !it.done(); }
+inline bool operator!=(SetBitsEnd, const detail::SetBitsIterator& it) { return !it.done(); }
+
+class set_bits_range {
+	const std::uint64_t* first;
+	const std::uint64_t* last;
+public:
+
+	set_bits_range(const std::uint64_t* first, const std::uint64_t* last): first(first), last(last) {}
+
+	detail::SetBitsIterator begin() const { return detail::SetBitsIterator(first, last); }
+	SetBitsEnd end() const { return {}; }
+
+};
+
+// The words have to outlive the range.
+inline set_bits_range set_bits(const std::uint64_t* words, std::size_t count) {
+	return set_bits_range(words, words + count);
+}
+
+inline set_bits_range set_bits(const std::vector<std::uint64_t>& words) {
+	return set_bits(words.data(), words.size());
+}
+
+// A temporary vector would be gone before the range is walked.
+set_bits_range set_bits(const std::vector<std::uint64_t>&&) = delete;
+
+// Counts the remaining set bits a word at a time.
+inline std::ptrdiff_t distance(const detail::SetBitsIterator& begin, SetBitsEnd) {
+	if(begin.done()) {
+		return 0;
+	}
+	std::ptrdiff_t answer = __builtin_popcountll(begin.remainingBits());
+	for(const std::uint64_t* word = begin.currentWord() + 1; word != begin.lastWord(); ++word) {
+		answer += __builtin_popcountll(*word);
+	}
+	return answer;
+}
+
+} // namespace ph
+
+#endif /* SET_BITS_HPP_ */
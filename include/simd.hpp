@@ -0,0 +1,361 @@
+#ifndef SIMD_HPP_
+#define SIMD_HPP_
+
+// Vectorised kernels for the common case of scanning contiguous chars until
+// one of a handful of delimiters, a NUL terminator, or a pointer bound.
+//
+// Stop conditions are recognised from the type of the End argument: any
+// ||-composition of untilValue(char), LazyStrIterator and plain char
+// pointers is answered 16 bytes at a time. Everything else keeps using the
+// element-by-element loop.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "ph.hpp"
+#include "LazyStrIterator.hpp"
+
+namespace ph { namespace detail {
+
+template<std::size_t N>
+struct CharSet {
+	std::array<char, N> values;
+	std::size_t count = 0;
+	// The bound is kept as a number of bytes from origin, so that a counted()
+	// budget larger than the data never forms a pointer past it.
+	const char* origin = nullptr;
+	std::ptrdiff_t limit = 0;
+	bool bounded = false;
+	bool nul = false;
+
+	void addValue(char c) { values[count++] = c; }
+
+	void addBound(const char* b) { addLimit(b, 0); }
+
+	void addLimit(const char* from, std::ptrdiff_t n) {
+		if(!bounded) {
+			origin = from;
+			limit = n;
+			bounded = true;
+		} else if(n + (from - origin) < limit) {
+			limit = n + (from - origin);
+		}
+	}
+
+	// How many bytes from p on come before the bound.
+	std::ptrdiff_t left(const char* p) const { return limit - (p - origin); }
+};
+
+template<typename End>
+struct CharScan {
+	static constexpr bool value = false;
+	static constexpr std::size_t values = 0;
+};
+
+template<>
+struct CharScan<ValueNode<char>> {
+	static constexpr bool value = true;
+	static constexpr std::size_t values = 1;
+
+	template<std::size_t N>
+	static void collect(const ValueNode<char>& node, CharSet<N>& set) {
+		set.addValue(node.value);
+	}
+};
+
+template<>
+struct CharScan<LazyStrIterator> {
+	static constexpr bool value = true;
+	static constexpr std::size_t values = 0;
+
+	template<std::size_t N>
+	static void collect(const LazyStrIterator&, CharSet<N>& set) {
+		set.nul = true;
+	}
+};
+
+template<>
+struct CharScan<const char*> {
+	static constexpr bool value = true;
+	static constexpr std::size_t values = 0;
+
+	template<std::size_t N>
+	static void collect(const char* bound, CharSet<N>& set) {
+		set.addBound(bound);
+	}
+};
+
+template<>
+struct CharScan<char*> : CharScan<const char*> {};
+
+template<>
+struct CharScan<OffsetNode<const char*>> {
+	static constexpr bool value = true;
+	static constexpr std::size_t values = 0;
+
+	template<std::size_t N>
+	static void collect(const OffsetNode<const char*>& node, CharSet<N>& set) {
+		set.addLimit(node.origin, node.n);
+	}
+};
+
+template<>
+struct CharScan<OffsetNode<char*>> {
+	static constexpr bool value = true;
+	static constexpr std::size_t values = 0;
+
+	template<std::size_t N>
+	static void collect(const OffsetNode<char*>& node, CharSet<N>& set) {
+		set.addLimit(node.origin, node.n);
+	}
+};
+
+template<typename T>
+struct CharScan<LeafNode<T>> {
+	static constexpr bool value = CharScan<T>::value;
+	static constexpr std::size_t values = CharScan<T>::values;
+
+	template<std::size_t N>
+	static void collect(const LeafNode<T>& node, CharSet<N>& set) {
+		CharScan<T>::collect(node.constraint, set);
+	}
+};
+
+template<typename LeftNode, typename RightNode>
+struct CharScan<OrNode<LeftNode, RightNode>> {
+	static constexpr bool value = CharScan<LeftNode>::value && CharScan<RightNode>::value;
+	static constexpr std::size_t values = CharScan<LeftNode>::values + CharScan<RightNode>::values;
+
+	template<std::size_t N>
+	static void collect(const OrNode<LeftNode, RightNode>& node, CharSet<N>& set) {
+		CharScan<LeftNode>::collect(node.leftNode, set);
+		CharScan<RightNode>::collect(node.rightNode, set);
+	}
+};
+
+template<typename End>
+CharSet<CharScan<End>::values> makeCharSet(const End& end) {
+	CharSet<CharScan<End>::values> set;
+	CharScan<End>::collect(end, set);
+	return set;
+}
+
+} // namespace detail
+
+namespace simd {
+
+template<std::size_t N>
+bool stops(char c, const detail::CharSet<N>& set) {
+	if(set.nul && c == '\0') {
+		return true;
+	}
+	for(std::size_t i = 0; i < set.count; ++i) {
+		if(c == set.values[i]) {
+			return true;
+		}
+	}
+	return false;
+}
+
+template<std::size_t N>
+const char* findAnyScalar(const char* begin, const detail::CharSet<N>& set) {
+	for(; !(set.bounded && set.left(begin) <= 0); ++begin) {
+		if(stops(*begin, set)) {
+			return begin;
+		}
+	}
+	return begin;
+}
+
+#ifdef __SSE2__
+// Compares 16 bytes at once against the values (and NUL) of a CharSet.
+template<std::size_t N>
+class Matcher {
+	__m128i needles[N ? N : 1];
+	std::size_t count;
+	bool nul;
+public:
+	explicit Matcher(const detail::CharSet<N>& set): needles(), count(set.count), nul(set.nul) {
+		for(std::size_t i = 0; i < count; ++i) {
+			needles[i] = _mm_set1_epi8(set.values[i]);
+		}
+	}
+
+	unsigned operator()(__m128i bytes) const {
+		const __m128i zero = _mm_setzero_si128();
+		__m128i hits = nul ? _mm_cmpeq_epi8(bytes, zero) : zero;
+		for(std::size_t i = 0; i < count; ++i) {
+			hits = _mm_or_si128(hits, _mm_cmpeq_epi8(bytes, needles[i]));
+		}
+		return static_cast<unsigned>(_mm_movemask_epi8(hits));
+	}
+};
+
+// Hides from the compiler which object p points into. Aligned loads may run
+// past the end of that object, like those of strlen, and the compiler must
+// neither warn about it nor optimise on it.
+inline const char* opaque(const char* p) {
+	__asm__("" : "+r"(p));
+	return p;
+}
+
+__attribute__((no_sanitize_address))
+inline __m128i load(const char* p) {
+	return _mm_load_si128(reinterpret_cast<const __m128i*>(opaque(p)));
+}
+
+// Unaligned loads have to stay within the object.
+inline __m128i loadUnaligned(const char* p) {
+	return _mm_loadu_si128(reinterpret_cast<const __m128i*>(opaque(p)));
+}
+
+#endif
+
+// Returns the first position before the bound of the set holding one of its
+// values, or NUL if requested, or the bound if nothing matched.
+//
+// Loads are 16 byte aligned, so like strlen they may touch bytes outside of
+// the range, but never outside of a page that holds part of it.
+template<std::size_t N>
+const char* findAny(const char* begin, const detail::CharSet<N>& set) {
+	if(set.bounded && (set.left(begin) <= 0 || (set.count == 0 && !set.nul))) {
+		return set.left(begin) > 0 ? begin + set.left(begin) : begin;
+	}
+#ifdef __SSE2__
+	const Matcher<N> match(set);
+
+	const std::size_t offset = reinterpret_cast<std::uintptr_t>(begin) & 15;
+	const char* block = begin - offset;
+	unsigned mask = match(load(block)) & (0xFFFFu << offset);
+
+	for(;;) {
+		if(set.bounded && set.left(block) <= 16) {
+			const std::ptrdiff_t left = set.left(block);
+			mask &= (1u << left) - 1;
+			return mask ? block + __builtin_ctz(mask) : block + left;
+		}
+		if(mask) {
+			return block + __builtin_ctz(mask);
+		}
+		block += 16;
+		mask = match(load(block));
+	}
+#else
+	return findAnyScalar(begin, set);
+#endif
+}
+
+#ifdef __SSE2__
+// Extends clear, the number of bytes from p on known to hold no stop, by the
+// aligned block holding p + clear. Returns false once the block holds the
+// first stop, clear then being its offset.
+template<std::size_t N>
+bool extendClear(const char* p, const Matcher<N>& match, std::ptrdiff_t& clear) {
+	const std::size_t misalignment = reinterpret_cast<std::uintptr_t>(p + clear) & 15;
+	const char* block = p + clear - misalignment;
+	const unsigned mask = match(load(block)) & (0xFFFFu << misalignment);
+	if(mask) {
+		clear = block + __builtin_ctz(mask) - p;
+		return false;
+	}
+	clear = block + 16 - p;
+	return true;
+}
+#endif
+
+// Returns the first offset at which a and b differ, or at which either of
+// them holds a stop of its set; for two NUL sets this is the loop of strcmp.
+// The sets must not have a bound.
+//
+// Stops are searched with aligned loads, which like those of findAny never
+// leave a page holding part of a string. a and b are only compared 16 bytes
+// at a time within the bytes known to come before their stops; the last
+// bytes before the first stop are compared one by one.
+template<std::size_t N1, std::size_t N2>
+std::ptrdiff_t mismatch(const char* a, const detail::CharSet<N1>& set1,
+		const char* b, const detail::CharSet<N2>& set2) {
+	std::ptrdiff_t offset = 0;
+#ifdef __SSE2__
+	const Matcher<N1> match1(set1);
+	const Matcher<N2> match2(set2);
+	std::ptrdiff_t clear1 = 0;
+	std::ptrdiff_t clear2 = 0;
+	bool more1 = true;
+	bool more2 = true;
+
+	for(;;) {
+		while(more1 && clear1 < offset + 16) {
+			more1 = extendClear(a, match1, clear1);
+		}
+		while(more2 && clear2 < offset + 16) {
+			more2 = extendClear(b, match2, clear2);
+		}
+		if(clear1 < offset + 16 || clear2 < offset + 16) {
+			break;
+		}
+		const __m128i bytes1 = loadUnaligned(a + offset);
+		const __m128i bytes2 = loadUnaligned(b + offset);
+		const unsigned differ = ~static_cast<unsigned>(
+			_mm_movemask_epi8(_mm_cmpeq_epi8(bytes1, bytes2))) & 0xFFFFu;
+		if(differ) {
+			return offset + __builtin_ctz(differ);
+		}
+		offset += 16;
+	}
+#endif
+	for(; a[offset] == b[offset] && !stops(a[offset], set1) && !stops(b[offset], set2); ++offset) {}
+	return offset;
+}
+
+// Whether any of the four 32 bit values at a equals any of the four at b,
+// comparing all sixteen pairs at once by rotating b.
+template<typename T>
+bool anyEqual4(const T* a, const T* b) {
+	static_assert(sizeof(T) == 4, "anyEqual4 compares 32 bit values");
+#ifdef __SSE2__
+	const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a));
+	const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b));
+	__m128i equal = _mm_cmpeq_epi32(va, vb);
+	equal = _mm_or_si128(equal, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1))));
+	equal = _mm_or_si128(equal, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))));
+	equal = _mm_or_si128(equal, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3))));
+	return _mm_movemask_epi8(equal) != 0;
+#else
+	bool equal = false;
+	for(int i = 0; i < 4; ++i) {
+		for(int j = 0; j < 4; ++j) {
+			equal |= a[i] == b[j];
+		}
+	}
+	return equal;
+#endif
+}
+
+// Returns the first word in [begin, end) that is not zero, or end. Sparse
+// bitsets are mostly zero words, which are skipped four at a time.
+inline const std::uint64_t* firstNonZero(const std::uint64_t* begin, const std::uint64_t* end) {
+#ifdef __SSE2__
+	const __m128i zero = _mm_setzero_si128();
+	for(; end - begin >= 4; begin += 4) {
+		const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+		const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin + 2));
+		if(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_or_si128(low, high), zero)) != 0xFFFF) {
+			break;
+		}
+	}
+#endif
+	for(; begin != end && !*begin; ++begin) {}
+	return begin;
+}
+
+} // namespace simd
+
+} // namespace ph
+
+#endif /* SIMD_HPP_ */
@@ -0,0 +1,266 @@
+#ifndef SUBSTRING_HPP_
+#define SUBSTRING_HPP_
+
+// A sentinel that stops after the first occurrence of any of several byte
+// strings, e.g. the end of an HTTP header or a MIME boundary:
+//
+//   auto stop = ph::untilSubstring("\r\n\r\n", "--boundary");
+//   auto bodyBegin = ph::next(buffer, buffer + size || stop);
+//   if(stop.matched()) { ... stop.pattern(), stop.position() ... }
+//
+// Unlike the other nodes it is stateful: every call feeds the element at the
+// given position into an automaton, so
+//
+//  * it sees each position once and in order, as the ph algorithms do; it
+//    must not stand on the right of && or be compared again at the same
+//    position;
+//  * it fires on the position after the match, as the match is only known
+//    once its last element was seen, so [begin, stop) includes the match;
+//  * bounds should come first in a ||, so that the position at the end is
+//    never fed to it;
+//  * copies share the state, which lets the caller ask the sentinel passed to
+//    an algorithm about the match, and lets a scan continue in a following
+//    buffer where the previous one left off.
+//
+// Patterns with up to 64 bytes in total are matched with shift-or, larger
+// sets with an Aho-Corasick automaton over the bytes used by the patterns.
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "ph.hpp"
+
+namespace ph {
+
+namespace detail {
+
+// Every pattern owns a run of bits of the state, a 0 bit at offset i of a
+// run meaning that the last i + 1 bytes equal the start of the pattern.
+class ShiftOr {
+	std::uint64_t masks[256];
+	std::uint64_t starts = 0;
+	std::uint64_t ends = 0;
+	std::uint64_t state = ~std::uint64_t(0);
+	std::vector<int> patternOfBit = std::vector<int>(64, -1);
+	std::vector<std::size_t> lengths;
+
+public:
+	explicit ShiftOr(const std::vector<std::string>& patterns) {
+		for(std::uint64_t& m: masks) {
+			m = ~std::uint64_t(0);
+		}
+		unsigned bit = 0;
+		for(std::size_t p = 0; p < patterns.size(); ++p) {
+			starts |= std::uint64_t(1) << bit;
+			for(char c: patterns[p]) {
+				masks[static_cast<unsigned char>(c)] &= ~(std::uint64_t(1) << bit++);
+			}
+			ends |= std::uint64_t(1) << (bit - 1);
+			patternOfBit[bit - 1] = static_cast<int>(p);
+			lengths.push_back(patterns[p].size());
+		}
+	}
+
+	// The longest pattern ending with c, or -1.
+	int feed(unsigned char c) {
+		state = ((state << 1) & ~starts) | masks[c];
+		std::uint64_t hits = ~state & ends;
+		if(!hits) {
+			return -1;
+		}
+		int best = -1;
+		for(; hits; hits &= hits - 1) {
+			const int p = patternOfBit[__builtin_ctzll(hits)];
+			if(best < 0 || lengths[p] > lengths[best]) {
+				best = p;
+			}
+		}
+		return best;
+	}
+
+	void reset() { state = ~std::uint64_t(0); }
+};
+
+// A complete transition table over byte classes, the bytes not used by any
+// pattern sharing class 0, so a step is a single table lookup.
+class AhoCorasick {
+	std::uint16_t classes[256] = {};
+	std::size_t classCount = 1;
+	std::vector<std::uint32_t> transitions; // transitions[state * classCount + class]
+	std::vector<int> output; // longest pattern ending in a state, or -1
+	std::uint32_t state = 0;
+
+	std::uint32_t& transition(std::uint32_t s, std::size_t c) { return transitions[s * classCount + c]; }
+
+public:
+	explicit AhoCorasick(const std::vector<std::string>& patterns) {
+		std::vector<bool> used(256);
+		for(const std::string& p: patterns) {
+			for(char c: p) {
+				used[static_cast<unsigned char>(c)] = true;
+			}
+		}
+		for(std::size_t c = 0; c < 256; ++c) {
+			if(used[c]) {
+				classes[c] = static_cast<std::uint16_t>(classCount++);
+			}
+		}
+
+		// The trie, 0 meaning no child as the root is nobody's child.
+		transitions.assign(classCount, 0);
+		output.assign(1, -1);
+		for(std::size_t p = 0; p < patterns.size(); ++p) {
+			std::uint32_t s = 0;
+			for(char c: patterns[p]) {
+				std::uint32_t& next = transition(s, classes[static_cast<unsigned char>(c)]);
+				if(!next) {
+					next = static_cast<std::uint32_t>(output.size());
+					output.push_back(-1);
+					transitions.resize(transitions.size() + classCount, 0);
+				}
+				s = transition(s, classes[static_cast<unsigned char>(c)]);
+			}
+			if(output[s] < 0) {
+				output[s] = static_cast<int>(p);
+			}
+		}
+
+		// Breadth first, so the failure state of a state is complete before
+		// the state itself. The transitions of a state are still those of the
+		// trie when it is reached, and the missing ones are filled in from its
+		// failure state.
+		std::vector<std::uint32_t> failure(output.size(), 0);
+		std::deque<std::uint32_t> queue;
+		for(std::size_t c = 0; c < classCount; ++c) {
+			if(const std::uint32_t child = transition(0, c)) {
+				queue.push_back(child);
+			}
+		}
+		while(!queue.empty()) {
+			const std::uint32_t s = queue.front();
+			queue.pop_front();
+			if(output[s] < 0) {
+				output[s] = output[failure[s]];
+			}
+			for(std::size_t c = 0; c < classCount; ++c) {
+				std::uint32_t& next = transition(s, c);
+				if(next) {
+					failure[next] = transition(failure[s], c);
+					queue.push_back(next);
+				} else {
+					next = transition(failure[s], c);
+				}
+			}
+		}
+	}
+
+	// The longest pattern ending with c, or -1.
+	int feed(unsigned char c) {
+		state = transitions[state * classCount + classes[c]];
+		return output[state];
+	}
+
+	void reset() { state = 0; }
+};
+
+} // namespace detail
+
+class SubstringNode {
+	struct State {
+		std::vector<std::string> patterns;
+		bool useShiftOr;
+		std::unique_ptr<detail::ShiftOr> shiftOr;
+		std::unique_ptr<detail::AhoCorasick> ahoCorasick;
+
+		std::ptrdiff_t seen = 0;
+		int matchedPattern = -1;
+		std::ptrdiff_t matchPosition = 0;
+	};
+
+	std::shared_ptr<State> state;
+
+public:
+	// Throws std::invalid_argument for an empty pattern, which would match
+	// everywhere.
+	explicit SubstringNode(std::vector<std::string> patterns): state(std::make_shared<State>()) {
+		std::size_t total = 0;
+		for(const std::string& p: patterns) {
+			if(p.empty()) {
+				throw std::invalid_argument("ph::untilSubstring: empty pattern");
+			}
+			total += p.size();
+		}
+		state->useShiftOr = total <= 64;
+		if(state->useShiftOr) {
+			state->shiftOr.reset(new detail::ShiftOr(patterns));
+		} else {
+			state->ahoCorasick.reset(new detail::AhoCorasick(patterns));
+		}
+		state->patterns = std::move(patterns);
+	}
+
+	template<typename Iterator>
+	bool operator()(Iterator&& it) const {
+		return feed(static_cast<unsigned char>(*it));
+	}
+
+	// Feeds one byte, returning whether a match was completed before it.
+	bool feed(unsigned char c) const {
+		State& s = *state;
+		if(s.matchedPattern >= 0) {
+			return true;
+		}
+		const int p = s.useShiftOr ? s.shiftOr->feed(c) : s.ahoCorasick->feed(c);
+		++s.seen;
+		if(p >= 0) {
+			s.matchedPattern = p;
+			s.matchPosition = s.seen - static_cast<std::ptrdiff_t>(s.patterns[p].size());
+		}
+		return false;
+	}
+
+	bool matched() const { return state->matchedPattern >= 0; }
+
+	// Index of the matched pattern in the order given to untilSubstring.
+	std::size_t pattern() const { return static_cast<std::size_t>(state->matchedPattern); }
+
+	const std::string& patternString() const { return state->patterns[state->matchedPattern]; }
+
+	// Offset of the start of the match from the first position fed since
+	// construction or the last reset.
+	std::ptrdiff_t position() const { return state->matchPosition; }
+
+	// Number of positions fed since construction or the last reset.
+	std::ptrdiff_t consumed() const { return state->seen; }
+
+	void reset() const {
+		State& s = *state;
+		if(s.useShiftOr) {
+			s.shiftOr->reset();
+		} else {
+			s.ahoCorasick->reset();
+		}
+		s.seen = 0;
+		s.matchedPattern = -1;
+		s.matchPosition = 0;
+	}
+
+};
+
+template<>
+struct IsNode<SubstringNode> : std::true_type {};
+
+template<typename... Patterns>
+SubstringNode untilSubstring(const Patterns&... patterns) {
+	return SubstringNode(std::vector<std::string>{std::string(patterns)...});
+}
+
+} // namespace ph
+
+#endif /* SUBSTRING_HPP_ */
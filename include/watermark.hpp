@@ -0,0 +1,160 @@
+#ifndef WATERMARK_HPP_
+#define WATERMARK_HPP_
+
+// Scanning a buffer while another thread is still filling it.
+//
+// The producer appends to a preallocated buffer and publishes the length of
+// the written prefix through a Watermark; consumers run the ph algorithms up
+// to a watermark_sentinel:
+//
+//   ph::Watermark w;
+//   // producer: write data[0, n), then w.publish(n); ... w.close();
+//   // consumers:
+//   ph::for_each(data, ph::make_watermark_sentinel(data, w), f);
+//
+// The sentinel caches the last length it read and compares positions with
+// that cached bound; the atomic length is only read again once the scan
+// reaches the bound. What it does there depends on the WatermarkWait policy,
+// and it fires once the scan reaches the published length of a closed
+// watermark.
+//
+// A sentinel and its copies belong to a single consumer thread; any number of
+// consumers can follow the same watermark with their own sentinels.
+//
+// In a ||, the sentinel has to come first, so that the other nodes only read
+// elements it found published.
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "ph.hpp"
+
+namespace ph {
+
+class Watermark {
+	std::atomic<std::size_t> published{0};
+	std::atomic<bool> closed{false};
+	std::atomic<int> sleepers{0};
+	std::mutex mutex;
+	std::condition_variable wakeUp;
+
+	void notify() {
+		// Sleepers register before they check the length, so either they see
+		// the new length or this sees them.
+		if(sleepers.load()) {
+			std::lock_guard<std::mutex> lock(mutex);
+			wakeUp.notify_all();
+		}
+	}
+
+public:
+	Watermark() = default;
+	Watermark(const Watermark&) = delete;
+	Watermark& operator=(const Watermark&) = delete;
+
+	// Lengths never decrease; everything before length must be written.
+	void publish(std::size_t length) {
+		published.store(length);
+		notify();
+	}
+
+	// No more data; sentinels fire at the published length.
+	void close() {
+		closed.store(true);
+		notify();
+	}
+
+	std::size_t length() const { return published.load(std::memory_order_acquire); }
+
+	bool isClosed() const { return closed.load(std::memory_order_acquire); }
+
+	// Blocks until the length exceeds position or the watermark is closed.
+	void wait(std::size_t position) {
+		++sleepers;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			wakeUp.wait(lock, [this, position]() { return published.load() > position || closed.load(); });
+		}
+		--sleepers;
+	}
+};
+
+enum class WatermarkWait {
+	None,  // fire at the watermark, like a snapshot of the length
+	Spin,  // busy wait for more data
+	Yield, // yield the thread while waiting
+	Block  // sleep until the producer publishes or closes
+};
+
+template<typename Iterator>
+class watermark_sentinel {
+	static_assert(std::is_same<typename std::iterator_traits<Iterator>::iterator_category,
+			std::random_access_iterator_tag>::value, "watermark_sentinel needs random access iterators");
+
+	Iterator base;
+	Watermark* watermark;
+	WatermarkWait waitPolicy;
+	mutable Iterator bound;
+
+	bool refresh(const Iterator& it) const {
+		for(;;) {
+			// Closed is read first, so the length read after it is final
+			// when it is set.
+			const bool closed = watermark->isClosed();
+			bound = base + watermark->length();
+			if(it < bound) {
+				return false;
+			}
+			if(closed) {
+				return true;
+			}
+			switch(waitPolicy) {
+			case WatermarkWait::None:
+				return true;
+			case WatermarkWait::Spin:
+#ifdef __SSE2__
+				_mm_pause();
+#endif
+				break;
+			case WatermarkWait::Yield:
+				std::this_thread::yield();
+				break;
+			case WatermarkWait::Block:
+				watermark->wait(it - base);
+				break;
+			}
+		}
+	}
+
+public:
+	watermark_sentinel(Iterator base, Watermark& watermark, WatermarkWait waitPolicy = WatermarkWait::Block):
+		base(base), watermark(&watermark), waitPolicy(waitPolicy), bound(base) {}
+
+	template<typename It>
+	bool operator()(It&& it) const {
+		return it < bound ? false : refresh(it);
+	}
+
+};
+
+template<typename Iterator>
+struct IsNode<watermark_sentinel<Iterator>> : std::true_type {};
+
+template<typename Iterator>
+watermark_sentinel<Iterator> make_watermark_sentinel(Iterator base, Watermark& watermark,
+		WatermarkWait waitPolicy = WatermarkWait::Block) {
+	return watermark_sentinel<Iterator>(base, watermark, waitPolicy);
+}
+
+} // namespace ph
+
+#endif /* WATERMARK_HPP_ */
@@ -2,7 +2,16 @@
 #include "adaptors.hpp"
 #include "ph.hpp"
 #include "algorithm.hpp"
+#include <list>
 #include <map>
+#include <stdexcept>
+#include <string>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "LazyStrIterator.hpp"
+#include "generator.hpp"
+#include "flat_map.hpp"
 #include <boost/test/unit_test.hpp>
 
 BOOST_AUTO_TEST_SUITE(RangeAdaptorsTestSuite)
@@ -113,6 +122,97 @@ BOOST_AUTO_TEST_CASE(Map_Keys_Pipe_should_work_with_untilvalue_that_exists) {
 
 }
 
+BOOST_AUTO_TEST_CASE(Map_Values_Pipe_should_yield_the_values) {
+	std::map<int, char> m = {{1, 'a'}, {2, 'b'}, {3, 'c'}};
+
+	auto range = ph::make_iterator_range(m.begin(), m.end()) | ph::adaptor::map_values;
+
+	std::string visited;
+	ph::for_each(range.begin(), range.end(), [&visited](char c) { visited += c; });
+
+	BOOST_CHECK_EQUAL(visited, "abc");
+}
+
+BOOST_AUTO_TEST_CASE(Flat_map_projections_should_be_contiguous_ranges) {
+	ph::flat_map<int, std::string> m = {{5, "five"}, {1, "one"}, {3, "three"}};
+	m[4] = "four";
+	m.insert(1, "uno");
+
+	auto keys = m | ph::adaptor::map_keys;
+	static_assert(std::is_same<decltype(keys), ph::Range<const int*, const int*>>::value, "keys are a pointer range");
+	auto expectedKeys = {1, 3, 4, 5};
+	BOOST_CHECK_EQUAL_COLLECTIONS(expectedKeys.begin(), expectedKeys.end(), keys.begin(), keys.end());
+
+	auto it = ph::find(keys.begin(), ph::untilValue(4) || keys.end(), 5);
+	BOOST_CHECK_EQUAL(it - keys.begin(), 2);
+	BOOST_CHECK_EQUAL(ph::count(keys.begin(), keys.end(), 3), 1);
+
+	auto values = m | ph::adaptor::map_values;
+	values.begin()[1] = "tres";
+	BOOST_CHECK_EQUAL(m.at(1), "one");
+	BOOST_CHECK_EQUAL(m.at(3), "tres");
+	BOOST_CHECK_THROW(m.at(2), std::out_of_range);
+
+	BOOST_CHECK_EQUAL(m.erase(4), 1u);
+	BOOST_CHECK_EQUAL(m.erase(4), 0u);
+	BOOST_CHECK(m.find(4) == m.end());
+	BOOST_CHECK_EQUAL((*m.find(5)).second, "five");
+
+	std::vector<int> visited;
+	for(auto element: m) {
+		visited.push_back(element.first);
+	}
+	auto expectedVisited = {1, 3, 5};
+	BOOST_CHECK_EQUAL_COLLECTIONS(expectedVisited.begin(), expectedVisited.end(), visited.begin(), visited.end());
+}
+
+namespace {
+
+template<typename Range, typename Adaptor, typename = void>
+struct CanPipe : std::false_type {};
+
+template<typename Range, typename Adaptor>
+struct CanPipe<Range, Adaptor, decltype(void(std::declval<Range>() | std::declval<Adaptor>()))> : std::true_type {};
+
+struct ThrowingCopy {
+	static bool fail;
+	ThrowingCopy() = default;
+	ThrowingCopy(const ThrowingCopy&) {
+		if(fail) {
+			throw std::runtime_error("copy");
+		}
+	}
+	ThrowingCopy& operator=(const ThrowingCopy&) = default;
+};
+
+bool ThrowingCopy::fail = false;
+
+} // unnamed namespace
+
+BOOST_AUTO_TEST_CASE(Flat_map_should_only_project_maps_that_outlive_the_range) {
+	using Map = ph::flat_map<int, std::string>;
+	static_assert(CanPipe<Map&, decltype(ph::adaptor::map_keys)>::value, "maps project by reference");
+	static_assert(CanPipe<const Map&, decltype(ph::adaptor::map_values)>::value, "maps project by reference");
+	static_assert(!CanPipe<Map, decltype(ph::adaptor::map_keys)>::value, "keys of a temporary map would dangle");
+	static_assert(!CanPipe<Map, decltype(ph::adaptor::map_values)>::value, "values of a temporary map would dangle");
+}
+
+BOOST_AUTO_TEST_CASE(Flat_map_insert_should_keep_keys_and_values_aligned_when_the_value_throws) {
+	ph::flat_map<int, ThrowingCopy> m;
+	m.insert(1, ThrowingCopy());
+	m.insert(3, ThrowingCopy());
+
+	ThrowingCopy::fail = true;
+	BOOST_CHECK_THROW(m.insert(2, ThrowingCopy()), std::runtime_error);
+	ThrowingCopy::fail = false;
+
+	BOOST_CHECK_EQUAL(m.size(), 2u);
+	BOOST_CHECK_EQUAL(ph::distance(m.keys().begin(), m.keys().end()), 2);
+	BOOST_CHECK_EQUAL(ph::distance(m.values().begin(), m.values().end()), 2);
+	BOOST_CHECK(m.find(2) == m.end());
+	BOOST_CHECK(m.find(3) != m.end());
+}
+
 BOOST_AUTO_TEST_CASE(Filtered_should_create_empty_range_for_empty_input) {
 	std::vector<int> v = {};
 	using iteratorType = std::vector<int>::iterator;
@@ -262,7 +362,136 @@ BOOST_AUTO_TEST_CASE(Filtered_should_create_identical_range_if_all_elements_sati
 
 }
 
-/*
+BOOST_AUTO_TEST_CASE(Split_should_yield_fields_between_delimiters_of_a_c_string) {
+	const char* str = "ab,c;,def";
+
+	auto range = ph::make_iterator_range(str, ph::LazyStrIterator{}) |
+		ph::adaptor::split(ph::untilValue(',', ';'));
+
+	std::vector<std::string> fields;
+	ph::for_each(range.begin(), range.end(), [&fields](const ph::Range<const char*, const char*>& f) {
+			fields.emplace_back(f.begin(), f.end());
+	});
+
+	auto expected = {"ab", "c", "", "def"};
+
+	BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(),
+			fields.begin(), fields.end());
+}
+
+BOOST_AUTO_TEST_CASE(Split_fields_should_point_into_the_input) {
+	std::string s = "1,22";
+
+	auto range = ph::make_iterator_range(s.begin(), s.end()) |
+		ph::adaptor::split(ph::untilValue(','));
+
+	auto it = range.begin();
+	BOOST_REQUIRE(it != range.end());
+	BOOST_CHECK((*it).begin() == s.begin());
+	BOOST_CHECK((*it).end() == s.begin() + 1);
+	++it;
+	BOOST_REQUIRE(it != range.end());
+	BOOST_CHECK((*it).begin() == s.begin() + 2);
+	BOOST_CHECK((*it).end() == s.end());
+	++it;
+	BOOST_CHECK(it == range.end());
+}
+
+BOOST_AUTO_TEST_CASE(Split_should_not_read_the_end_of_the_last_field) {
+	std::vector<char> v = {'a', ',', 'b', 'c'};
+
+	auto range = ph::make_iterator_range(v.begin(), v.end()) |
+		ph::adaptor::split(ph::until([](char c) { return c == ','; }));
+
+	std::vector<std::string> fields;
+	ph::for_each(range.begin(), range.end(), [&fields](const ph::Range<std::vector<char>::iterator, std::vector<char>::iterator>& f) {
+			fields.emplace_back(f.begin(), f.end());
+	});
+
+	auto expected = {"a", "bc"};
+	BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(),
+			fields.begin(), fields.end());
+}
+
+BOOST_AUTO_TEST_CASE(Split_should_bound_forward_iterators_with_counted) {
+	std::list<char> l = {'a', ',', 'b', 'c', ',', 'd', 'e', 'f', ',', 'g'};
+
+	auto range = ph::make_iterator_range(l.begin(), ph::counted(7)) |
+		ph::adaptor::split(ph::untilValue(','));
+
+	std::vector<std::string> fields;
+	ph::for_each(range.begin(), range.end(), [&fields](const ph::Range<std::list<char>::iterator, std::list<char>::iterator>& f) {
+			fields.emplace_back(f.begin(), f.end());
+	});
+
+	auto expected = {"a", "bc", "de"};
+	BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(),
+			fields.begin(), fields.end());
+}
+
+BOOST_AUTO_TEST_CASE(Split_should_yield_a_trailing_empty_field) {
+	const char* str = "a,b,";
+
+	auto range = ph::make_iterator_range(str, str + 4) |
+		ph::adaptor::split(ph::untilValue(','));
+
+	BOOST_CHECK_EQUAL(ph::distance(range.begin(), range.end()), 3);
+}
+
+BOOST_AUTO_TEST_CASE(Split_should_stop_at_a_long_unaligned_bound) {
+	std::string s(100, 'x');
+	s[40] = ',';
+	s[90] = ',';
+	const char* str = s.c_str() + 3;
+
+	auto range = ph::make_iterator_range(str, str + 80) |
+		ph::adaptor::split(ph::untilValue(','));
+
+	std::vector<std::size_t> lengths;
+	ph::for_each(range.begin(), range.end(), [&lengths](const ph::Range<const char*, const char*>& f) {
+			lengths.push_back(f.end() - f.begin());
+	});
+
+	auto expected = {37u, 42u};
+
+	BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(),
+			lengths.begin(), lengths.end());
+}
+
+BOOST_AUTO_TEST_CASE(Zip_should_stop_at_whichever_range_ends_first) {
+	const char* str = "abcd";
+	std::vector<int> v = {1, 2, 3, 0, 5};
+
+	auto zipped = ph::adaptor::zip(
+			ph::make_iterator_range(str, ph::LazyStrIterator{}),
+			ph::make_iterator_range(v.begin(), ph::untilValue(0)));
+
+	std::string chars;
+	std::vector<int> ints;
+	ph::for_each(zipped.begin(), zipped.end(), [&](const std::pair<const char&, int&>& p) {
+			chars += p.first;
+			ints.push_back(p.second);
+	});
+
+	BOOST_CHECK_EQUAL(chars, "abc");
+	BOOST_CHECK_EQUAL(ints.size(), 3u);
+	BOOST_CHECK_EQUAL(ph::distance(zipped.begin(), zipped.end()), 3);
+}
+
+BOOST_AUTO_TEST_CASE(Zip_should_give_writable_references) {
+	std::vector<int> v1 = {1, 2, 3};
+	std::vector<int> v2 = {0, 0, 0, 0};
+
+	auto zipped = ph::adaptor::zip(
+			ph::make_iterator_range(v1.begin(), v1.end()),
+			ph::make_iterator_range(v2.begin(), v2.end()));
+
+	ph::for_each(zipped.begin(), zipped.end(), [](std::pair<int&, int&> p) { p.second = p.first; });
+
+	auto expected = {1, 2, 3, 0};
+	BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), v2.begin(), v2.end());
+}
+
 BOOST_AUTO_TEST_CASE(Filtered_pipe_should_create_identical_range_if_all_elements_satisfy) {
 	std::vector<int> v = {1, 2, 3};
 
@@ -282,7 +511,401 @@ BOOST_AUTO_TEST_CASE(Filtered_pipe_should_create_identical_range_if_all_elements
 			actualRange.begin(), actualRange.end());
 
 }
-*/
-// TODO Fix above, something undefined is going on.. But only from the pipe.
+
+BOOST_AUTO_TEST_CASE(Async_buffered_should_deliver_upstream_elements_in_order) {
+	std::vector<int> v;
+	for(int i = 0; i < 10000; ++i) {
+		v.push_back(i);
+	}
+
+	auto range = ph::make_iterator_range(v.begin(), v.end()) |
+		ph::adaptor::filtered([](const int& i) { return i % 3 == 0; }) |
+		ph::adaptor::async_buffered(16, 4);
+
+	std::vector<int> visited;
+	ph::for_each(range.begin(), range.end(), [&visited](int i) { visited.push_back(i); });
+
+	BOOST_REQUIRE_EQUAL(visited.size(), 3334u);
+	for(std::size_t i = 0; i < visited.size(); ++i) {
+		BOOST_CHECK_EQUAL(visited[i], static_cast<int>(i * 3));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(Async_buffered_should_end_where_the_upstream_sentinel_fires) {
+	std::vector<int> v = {1, 2, 3, 4, 0, 5, 6};
+
+	auto range = ph::make_iterator_range(v.begin(), ph::untilValue(0)) |
+		ph::adaptor::async_buffered(4, 1);
+
+	BOOST_CHECK_EQUAL(ph::distance(range.begin(), range.end()), 4);
+}
+
+BOOST_AUTO_TEST_CASE(Async_buffered_end_should_compose_with_until) {
+	std::vector<int> v = {1, 2, 3, 4, 5, 6};
+
+	auto range = ph::make_iterator_range(v.begin(), v.end()) |
+		ph::adaptor::async_buffered(64);
+
+	auto it = ph::find(range.begin(), ph::untilValue(5) || range.end(), 9);
+	BOOST_CHECK_EQUAL(*it, 5);
+}
+
+BOOST_AUTO_TEST_CASE(Async_buffered_should_stop_its_producer_when_destroyed_early) {
+	std::atomic<int> produced(0);
+	auto g = ph::make_generator<int>([&produced](int& out) {
+		out = produced++;
+		return true;
+	});
+
+	{
+		auto range = ph::make_iterator_range(g.begin(), g.end()) |
+			ph::adaptor::async_buffered(8, 2);
+		auto it = ph::find(range.begin(), range.end(), 20);
+		BOOST_CHECK_EQUAL(*it, 20);
+	}
+
+	const int producedAfterDestruction = produced;
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	BOOST_CHECK_EQUAL(produced, producedAfterDestruction);
+	BOOST_CHECK(producedAfterDestruction < 1000);
+}
+
+BOOST_AUTO_TEST_CASE(Async_buffered_should_hand_over_elements_of_a_slow_upstream_before_the_batch_is_full) {
+	std::atomic<bool> seen(false);
+	int calls = 0;
+	auto g = ph::make_generator<int>([&seen, &calls](int& out) {
+		if(++calls == 1) {
+			out = 1;
+			return true;
+		}
+		if(calls > 2) {
+			return false;
+		}
+		// The second element only comes once the first was consumed.
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+		while(!seen && std::chrono::steady_clock::now() < deadline) {
+			std::this_thread::yield();
+		}
+		out = 2;
+		return seen.load();
+	});
+
+	auto range = ph::make_iterator_range(g.begin(), g.end()) |
+		ph::adaptor::async_buffered(64, 64);
+	auto it = range.begin();
+	BOOST_REQUIRE(it != range.end());
+	BOOST_CHECK_EQUAL(*it, 1);
+	seen = true;
+	++it;
+	BOOST_REQUIRE(it != range.end());
+	BOOST_CHECK_EQUAL(*it, 2);
+}
+
+BOOST_AUTO_TEST_CASE(Merged_should_merge_ranges_with_different_sentinels) {
+	const char* str = "aeiou";
+	std::vector<char> v = {'b', 'c', 'x', '!', 'y'};
+	std::list<char> l = {'a', 'd', 'z'};
+
+	auto all = ph::adaptor::merged(
+			ph::make_iterator_range(str, ph::LazyStrIterator{}),
+			ph::make_iterator_range(v.begin(), ph::untilValue('!')),
+			ph::make_iterator_range(l.begin(), l.end()));
+
+	std::string merged;
+	ph::for_each(all.begin(), all.end(), [&merged](char c) { merged += c; });
+
+	BOOST_CHECK_EQUAL(merged, "aabcdeiouxz");
+}
+
+BOOST_AUTO_TEST_CASE(Merged_should_be_stable_and_skip_empty_ranges) {
+	std::vector<std::pair<int, int>> v1 = {{1, 0}, {2, 0}};
+	std::vector<std::pair<int, int>> v2;
+	std::vector<std::pair<int, int>> v3 = {{1, 0}, {2, 0}, {3, 0}};
+
+	auto all = ph::adaptor::merged(
+			ph::make_iterator_range(v1.begin(), v1.end()),
+			ph::make_iterator_range(v2.begin(), v2.end()),
+			ph::make_iterator_range(v3.begin(), ph::counted(3)));
+
+	std::vector<std::size_t> sources;
+	for(auto it = all.begin(); it != all.end(); ++it) {
+		sources.push_back(it.source());
+	}
+
+	auto expected = {0u, 2u, 0u, 2u, 2u};
+	BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), sources.begin(), sources.end());
+
+	auto none = ph::adaptor::merged(ph::make_iterator_range(v2.begin(), v2.end()));
+	BOOST_CHECK(none.begin() == none.end());
+}
+
+BOOST_AUTO_TEST_CASE(Merged_should_merge_many_ranges) {
+	std::vector<std::vector<int>> shards(11);
+	for(int i = 0; i < 1000; ++i) {
+		shards[(i * 7) % 11].push_back(i);
+	}
+
+	auto range = [&shards](std::size_t i) { return ph::make_iterator_range(shards[i].begin(), shards[i].end()); };
+	auto all = ph::adaptor::merged(range(0), range(1), range(2), range(3), range(4), range(5),
+			range(6), range(7), range(8), range(9), range(10));
+
+	int expected = 0;
+	for(auto it = all.begin(); it != all.end(); ++it, ++expected) {
+		BOOST_REQUIRE_EQUAL(*it, expected);
+	}
+	BOOST_CHECK_EQUAL(expected, 1000);
+}
+
+BOOST_AUTO_TEST_CASE(Runs_should_give_value_and_length_of_every_run) {
+	std::vector<int> v;
+	std::vector<std::pair<int, std::ptrdiff_t>> expected;
+	for(int value = 1; value < 40; ++value) {
+		const int length = (value * 37) % 150 + 1;
+		v.insert(v.end(), length, value % 3 + 1);
+		if(!expected.empty() && expected.back().first == value % 3 + 1) {
+			expected.back().second += length;
+		} else {
+			expected.emplace_back(value % 3 + 1, length);
+		}
+	}
+	v.push_back(0);
+
+	auto check = [&expected](const auto& range) {
+		std::vector<std::pair<int, std::ptrdiff_t>> runs;
+		ph::for_each(range.begin(), range.end(), [&runs](const auto& run) {
+				runs.emplace_back(run.front(), run.size());
+		});
+		BOOST_REQUIRE_EQUAL(runs.size(), expected.size());
+		for(std::size_t i = 0; i < runs.size(); ++i) {
+			BOOST_CHECK_EQUAL(runs[i].first, expected[i].first);
+			BOOST_CHECK_EQUAL(runs[i].second, expected[i].second);
+		}
+	};
+
+	check(ph::make_iterator_range(v.data(), v.data() + v.size() - 1) | ph::adaptor::runs());
+	check(ph::make_iterator_range(v.data(), ph::untilValue(0)) | ph::adaptor::runs());
+	check(ph::make_iterator_range(v.begin(), ph::untilValue(0)) | ph::adaptor::runs());
+	std::list<int> l(v.begin(), v.end());
+	check(ph::make_iterator_range(l.begin(), ph::counted(v.size() - 1)) | ph::adaptor::runs());
+}
+
+BOOST_AUTO_TEST_CASE(Chunk_by_should_split_where_the_predicate_fails) {
+	const char* str = "abcabxyz";
+
+	auto chunks = ph::make_iterator_range(str, ph::LazyStrIterator{}) |
+		ph::adaptor::chunk_by([](char a, char b) { return a < b; });
+
+	std::vector<std::string> visited;
+	ph::for_each(chunks.begin(), chunks.end(), [&visited](const ph::adaptor::detail::Chunk<const char*>& c) {
+			visited.emplace_back(c.begin(), c.end());
+	});
+
+	auto expected = {"abc", "abxyz"};
+	BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), visited.begin(), visited.end());
+
+	auto empty = ph::make_iterator_range(str, str) | ph::adaptor::runs();
+	BOOST_CHECK(!(empty.begin() != empty.end()));
+}
+
+BOOST_AUTO_TEST_CASE(Chunk_by_iterators_should_be_multi_pass) {
+	const char* str = "abcabxyzab";
+
+	auto chunks = ph::make_iterator_range(str, ph::LazyStrIterator{}) |
+		ph::adaptor::chunk_by([](char a, char b) { return a < b; });
+
+	auto first = chunks.begin();
+	auto second = first;
+	++second;
+	BOOST_CHECK(first != second);
+	BOOST_CHECK_EQUAL(std::string((*first).begin(), (*first).end()), "abc");
+	BOOST_CHECK_EQUAL(std::string((*second).begin(), (*second).end()), "abxyz");
+
+	++first;
+	BOOST_CHECK(first == second);
+	++first;
+	++first;
+	++second;
+	++second;
+	BOOST_CHECK(first == chunks.end());
+	BOOST_CHECK(first == second);
+}
+
+BOOST_AUTO_TEST_CASE(Concat_should_scan_across_fragments_without_copying) {
+	const std::string message = "GET /index HTTP/1.1\nHost: example\n\nbody";
+	for(std::size_t cut: {0u, 1u, 3u, 7u, 16u, 19u, 20u, 33u}) {
+		std::vector<ph::Range<const char*, const char*>> fragments;
+		const char* data = message.data();
+		fragments.push_back(ph::make_iterator_range(data, data + cut));
+		fragments.push_back(ph::make_iterator_range(data + cut, data + cut));
+		fragments.push_back(ph::make_iterator_range(data + cut, data + message.size()));
+
+		auto all = ph::adaptor::concat(fragments);
+
+		auto colon = ph::find(all.begin(), all.end(), ':');
+		BOOST_CHECK_EQUAL(ph::distance(all.begin(), colon), 24);
+		auto line = ph::next(all.begin(), ph::untilValue('\n') || all.end());
+		BOOST_CHECK_EQUAL(ph::distance(all.begin(), line), 19);
+		BOOST_CHECK_EQUAL(*line, '\n');
+		auto none = ph::find(all.begin(), ph::untilValue('\n') || all.end(), ':');
+		BOOST_CHECK(none == line);
+
+		BOOST_CHECK_EQUAL(ph::count(all.begin(), all.end(), '\n'), 3);
+		BOOST_CHECK_EQUAL(ph::count_if(all.begin(), all.end() || ph::until([](char c) { return c == 'H'; }),
+				[](char c) { return c == 'e'; }), 1);
+
+		std::string copy;
+		ph::for_each(all.begin(), all.end(), [&copy](char c) { copy += c; });
+		BOOST_CHECK_EQUAL(copy, message);
+		BOOST_CHECK(ph::next(all.begin(), all.end()) == all.end());
+	}
+}
+
+BOOST_AUTO_TEST_CASE(Concat_should_scan_every_segment_once) {
+	std::vector<std::list<char>> fragments = {{'a', 'b'}, {}, {'c', 'd', 'e'}, {'f', '!', 'g'}};
+	auto all = ph::adaptor::concat(fragments);
+
+	int calls = 0;
+	auto bang = [&calls](char c) { ++calls; return c == '!'; };
+
+	auto it = ph::find(all.begin(), ph::until(bang) || all.end(), 'z');
+	BOOST_CHECK_EQUAL(*it, '!');
+	BOOST_CHECK_EQUAL(calls, 7);
+
+	calls = 0;
+	BOOST_CHECK(ph::next(all.begin(), all.end() || ph::until(bang)) == it);
+	BOOST_CHECK_EQUAL(calls, 7);
+
+	calls = 0;
+	std::string visited;
+	ph::for_each(all.begin(), ph::until(bang) || all.end(), [&visited](char c) { visited += c; });
+	BOOST_CHECK_EQUAL(visited, "abcdef");
+	BOOST_CHECK_EQUAL(calls, 7);
+
+	BOOST_CHECK_EQUAL(ph::count(all.begin(), ph::until(bang) || all.end(), 'e'), 1);
+	BOOST_CHECK_EQUAL(ph::count(all.begin(), ph::untilValue('!') || all.end(), 'g'), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Concat_of_several_ranges_should_pipe_into_adaptors) {
+	const std::string head = "GET / HTTP/1.1\nHo";
+	const std::string tail = "st: x\n\nbody";
+	auto ra = ph::make_iterator_range(head.data(), head.data() + head.size());
+	auto rb = ph::make_iterator_range(tail.data(), tail.data() + tail.size());
+
+	auto firstLine = ph::adaptor::concat(ra, rb) | ph::adaptor::take_until(ph::untilValue('\n'));
+	std::string line;
+	ph::for_each(firstLine.begin(), firstLine.end(), [&line](char c) { line += c; });
+	BOOST_CHECK_EQUAL(line, "GET / HTTP/1.1");
+
+	auto body = ph::adaptor::concat(ra, rb) | ph::adaptor::drop_until(ph::untilValue('b'));
+	BOOST_CHECK_EQUAL(ph::distance(body.begin(), body.end()), 4);
+}
+
+BOOST_AUTO_TEST_CASE(Concat_should_join_ranges_with_sentinel_ends) {
+	const char* first = "ab";
+	const char* second = "";
+	const char* third = "cd";
+
+	auto all = ph::adaptor::concat(
+			ph::make_iterator_range(first, ph::LazyStrIterator{}),
+			ph::make_iterator_range(second, ph::LazyStrIterator{}),
+			ph::make_iterator_range(third, ph::LazyStrIterator{}));
+
+	std::string joined;
+	for(auto it = all.begin(); it != all.end(); ++it) {
+		joined += *it;
+	}
+	BOOST_CHECK_EQUAL(joined, "abcd");
+	BOOST_CHECK_EQUAL(*ph::find_if(all.begin(), all.end(), [](char c) { return c > 'b'; }), 'c');
+
+	std::vector<std::string> words = {"", "one", "", "two"};
+	auto letters = ph::adaptor::concat(words);
+	BOOST_CHECK_EQUAL(ph::distance(letters.begin(), letters.end()), 6);
+	BOOST_CHECK_EQUAL(ph::distance(letters.begin(), ph::counted(4) || letters.end()), 4);
+}
+
+BOOST_AUTO_TEST_CASE(Take_until_should_count_the_filtered_elements) {
+	const std::string text = "a1b2c3d4e5";
+	std::list<char> l(text.begin(), text.end());
+	auto isLetter = [](char c) { return c < '0' || c > '9'; };
+
+	auto firstThree = ph::make_iterator_range(l.begin(), l.end()) |
+		ph::adaptor::filtered(isLetter) | ph::adaptor::take_until(ph::counted(3));
+
+	std::string visited;
+	ph::for_each(firstThree.begin(), firstThree.end(), [&visited](char c) { visited += c; });
+	BOOST_CHECK_EQUAL(visited, "abc");
+
+	auto all = ph::make_iterator_range(l.begin(), l.end()) |
+		ph::adaptor::filtered(isLetter) | ph::adaptor::take_until(ph::counted(50));
+	BOOST_CHECK_EQUAL(ph::distance(all.begin(), all.end()), 5);
+
+	auto filtered = ph::make_iterator_range(l.begin(), l.end()) | ph::adaptor::filtered(isLetter);
+	auto second = filtered.begin();
+	++second;
+	BOOST_CHECK(second != filtered.begin());
+	BOOST_CHECK(second == ph::next(filtered.begin(), ph::counted(1)));
+}
+
+BOOST_AUTO_TEST_CASE(Take_until_should_cut_a_pipeline_where_the_tree_fires) {
+	const std::string text = "a1b2c3\nd4e5";
+
+	auto letters = ph::make_iterator_range(text.begin(), text.end()) |
+		ph::adaptor::filtered([](char c) { return c < '0' || c > '9'; }) |
+		ph::adaptor::take_until(ph::untilValue('\n'));
+
+	std::string visited;
+	ph::for_each(letters.begin(), letters.end(), [&visited](char c) { visited += c; });
+	BOOST_CHECK_EQUAL(visited, "abc");
+
+	auto line = ph::make_iterator_range(text.data(), text.data() + text.size()) |
+		ph::adaptor::take_until(ph::untilValue('\n'));
+	BOOST_CHECK_EQUAL(ph::distance(line.begin(), line.end()), 6);
+	BOOST_CHECK(ph::find(line.begin(), line.end(), 'd') == text.data() + 6);
+	BOOST_CHECK_EQUAL(ph::count(line.begin(), line.end(), 'b'), 1);
+
+	auto bounded = ph::make_iterator_range(text.data(), ph::untilValue('\n')) |
+		ph::adaptor::take_until(ph::counted(2));
+	BOOST_CHECK_EQUAL(ph::distance(bounded.begin(), bounded.end()), 2);
+
+	auto none = ph::make_iterator_range(text.data(), text.data() + text.size()) |
+		ph::adaptor::take_until(ph::untilValue('x'));
+	BOOST_CHECK_EQUAL(ph::distance(none.begin(), none.end()), 11);
+}
+
+BOOST_AUTO_TEST_CASE(Drop_until_should_start_where_the_tree_fires) {
+	std::vector<int> v = {1, 2, 3, 4, 5, 6, 0, 7};
+
+	auto tail = ph::make_iterator_range(v.data(), ph::untilValue(0)) |
+		ph::adaptor::drop_until(ph::untilValue(4));
+	BOOST_CHECK(tail.begin() == v.data() + 3);
+	BOOST_CHECK_EQUAL(ph::distance(tail.begin(), tail.end()), 3);
+
+	auto budget = ph::make_iterator_range(v.begin(), ph::counted(5)) |
+		ph::adaptor::drop_until(ph::untilValue(3));
+	BOOST_CHECK_EQUAL(ph::distance(budget.begin(), budget.end()), 3);
+
+	auto empty = ph::make_iterator_range(v.begin(), v.end()) |
+		ph::adaptor::drop_until(ph::untilValue(9));
+	BOOST_CHECK(empty.begin() == v.end());
+
+	std::list<int> l(v.begin(), v.end());
+	auto counted = ph::make_iterator_range(l.begin(), ph::counted(5)) |
+		ph::adaptor::drop_until(ph::untilValue(3));
+	BOOST_CHECK_EQUAL(*counted.begin(), 3);
+	BOOST_CHECK_EQUAL(ph::distance(counted.begin(), counted.end()), 3);
+}
+
+BOOST_AUTO_TEST_CASE(Take_while_and_drop_while_should_split_at_the_first_failure) {
+	std::vector<int> v = {2, 4, 6, 7, 8};
+	auto even = [](int i) { return i % 2 == 0; };
+	auto all = ph::make_iterator_range(v.begin(), v.end());
+
+	auto head = all | ph::adaptor::take_while(even);
+	auto tail = all | ph::adaptor::drop_while(even);
+
+	BOOST_CHECK_EQUAL(ph::distance(head.begin(), head.end()), 3);
+	BOOST_CHECK(tail.begin() == v.begin() + 3);
+	BOOST_CHECK_EQUAL(ph::distance(tail.begin(), tail.end()), 2);
+}
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -3,6 +3,17 @@
 #include "ph.hpp"
 #include "range.hpp"
 #include "algorithm.hpp"
+#include "LazyStrIterator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <list>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include <string>
 
 BOOST_AUTO_TEST_SUITE(algorithmTest)
 
@@ -88,5 +99,261 @@ BOOST_AUTO_TEST_CASE(distance_test_for_empty_range) {
 			std::distance(v.begin(), v.end()));
 }
 
+BOOST_AUTO_TEST_CASE(next_should_stop_where_the_end_compares_equal) {
+	std::vector<int> v = {1, 2, 3, 4, 5};
+
+	BOOST_CHECK(ph::next(v.begin(), ph::untilValue(4)) == v.begin() + 3);
+	BOOST_CHECK(ph::next(v.begin(), v.end() || ph::untilValue(9)) == v.end());
+}
+
+BOOST_AUTO_TEST_CASE(next_on_c_string_should_match_scalar_scan_at_every_offset) {
+	std::string s(70, 'a');
+	s[33] = ';';
+	s[61] = ',';
+
+	for(std::size_t offset = 0; offset < s.size(); ++offset) {
+		const char* str = s.c_str() + offset;
+		auto delimiter = ph::untilValue(',', ';');
+
+		const char* expected = str + std::strcspn(str, ",;");
+
+		BOOST_CHECK_EQUAL(ph::next(str, delimiter || ph::LazyStrIterator{}), expected);
+		if(offset + 5 <= s.size()) {
+			BOOST_CHECK_EQUAL(ph::next(str, delimiter || (str + 5)), std::min(expected, str + 5));
+		}
+		BOOST_CHECK_EQUAL(ph::next(str, ph::LazyStrIterator{}), s.c_str() + s.size());
+	}
+}
+
+BOOST_AUTO_TEST_CASE(galloping_searches_should_agree_with_std_for_every_end_kind) {
+	std::vector<int> ids = { 1, 3, 3, 3, 7, 9, 12, 12, 20, 31, 40, 41, 55, 60, 61, 99, 0 };
+	const auto size = ids.size() - 1;
+	auto terminated = ph::untilValue(0);
+
+	for(int value = 0; value <= 100; ++value) {
+		const auto lower = std::lower_bound(ids.begin(), ids.begin() + size, value);
+		const auto upper = std::upper_bound(ids.begin(), ids.begin() + size, value);
+
+		BOOST_CHECK(ph::lower_bound(ids.begin(), terminated, value) == lower);
+		BOOST_CHECK(ph::lower_bound(ids.begin(), ph::counted(size), value) == lower);
+		BOOST_CHECK(ph::upper_bound(ids.begin(), terminated, value) == upper);
+		BOOST_CHECK(ph::upper_bound(ids.begin(), ph::counted(size), value, std::less<int>()) == upper);
+		BOOST_CHECK(ph::equal_range(ids.begin(), terminated, value) == std::make_pair(lower, upper));
+		BOOST_CHECK(ph::equal_range(ids.begin(), ph::counted(size), value) == std::make_pair(lower, upper));
+		BOOST_CHECK_EQUAL(ph::binary_search(ids.begin(), terminated, value), lower != upper);
+		BOOST_CHECK(ph::partition_point(ids.begin(), terminated, [value](int i) { return i < value; }) == lower);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(galloping_searches_should_work_on_forward_iterators) {
+	std::list<int> l = { 2, 4, 4, 8, 16 };
+
+	BOOST_CHECK_EQUAL(*ph::lower_bound(l.begin(), ph::counted(5), 4), 4);
+	BOOST_CHECK_EQUAL(std::distance(l.begin(), ph::upper_bound(l.begin(), ph::untilValue(16), 4)), 3);
+	BOOST_CHECK(ph::lower_bound(l.begin(), ph::untilValue(16), 100) == std::next(l.begin(), 4));
+	BOOST_CHECK(!ph::binary_search(l.begin(), ph::counted(5), 5));
+}
+
+BOOST_AUTO_TEST_CASE(set_operations_should_agree_with_std_on_delimited_ranges) {
+	std::vector<int> a = { 1, 2, 2, 2, 5, 8, 9, 9, 13, 21, 34, 35, 36, 37, 38, 40, 0 };
+	std::vector<int> b = { 2, 2, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 40, 41, 0 };
+	const auto aEnd = a.end() - 1;
+	const auto bEnd = b.end() - 1;
+	std::list<int> l(b.begin(), bEnd);
+
+	std::vector<int> expected, actual;
+	std::set_intersection(a.begin(), aEnd, b.begin(), bEnd, std::back_inserter(expected));
+	ph::set_intersection(a.begin(), ph::untilValue(0), b.begin(), ph::untilValue(0), std::back_inserter(actual));
+	BOOST_CHECK(actual == expected);
+	actual.clear();
+	ph::set_intersection(a.data(), ph::counted(aEnd - a.begin()), b.data(), b.data() + (bEnd - b.begin()), std::back_inserter(actual));
+	BOOST_CHECK(actual == expected);
+	actual.clear();
+	ph::set_intersection(a.begin(), ph::untilValue(0), l.begin(), ph::counted(l.size()), std::back_inserter(actual), std::less<int>());
+	BOOST_CHECK(actual == expected);
+
+	expected.clear();
+	actual.clear();
+	std::set_union(a.begin(), aEnd, b.begin(), bEnd, std::back_inserter(expected));
+	ph::set_union(a.begin(), ph::untilValue(0), l.begin(), l.end(), std::back_inserter(actual));
+	BOOST_CHECK(actual == expected);
+
+	expected.clear();
+	actual.clear();
+	std::set_difference(a.begin(), aEnd, b.begin(), bEnd, std::back_inserter(expected));
+	ph::set_difference(a.begin(), ph::untilValue(0), b.begin(), ph::untilValue(0), std::back_inserter(actual));
+	BOOST_CHECK(actual == expected);
+
+	expected.clear();
+	actual.clear();
+	std::merge(a.begin(), aEnd, b.begin(), bEnd, std::back_inserter(expected));
+	ph::merge(l.begin(), ph::counted(l.size()), a.begin(), ph::untilValue(0), std::back_inserter(actual));
+	BOOST_CHECK(actual == expected);
+}
+
+BOOST_AUTO_TEST_CASE(set_intersection_should_handle_skewed_sizes) {
+	std::vector<int> large(10000);
+	for(std::size_t i = 0; i < large.size(); ++i) {
+		large[i] = static_cast<int>(3 * i);
+	}
+	std::vector<int> small = { 0, 3, 4, 2999, 3000, 15000, 29997, 30000 };
+
+	std::vector<int> expected, actual, reversed;
+	std::set_intersection(small.begin(), small.end(), large.begin(), large.end(), std::back_inserter(expected));
+	ph::set_intersection(small.data(), ph::counted(small.size()), large.data(), ph::counted(large.size()), std::back_inserter(actual));
+	ph::set_intersection(large.begin(), ph::counted(large.size()), small.begin(), ph::counted(small.size()), std::back_inserter(reversed));
+
+	BOOST_CHECK(actual == expected);
+	BOOST_CHECK(reversed == expected);
+}
+
+BOOST_AUTO_TEST_CASE(top_k_should_agree_with_partial_sort) {
+	std::vector<int> v;
+	for(int i = 0; i < 20000; ++i) {
+		v.push_back((i * 7919) % 10007 + 1);
+	}
+	v.push_back(0);
+	std::vector<int> sorted(v.begin(), v.end() - 1);
+	std::sort(sorted.begin(), sorted.end(), std::greater<int>());
+
+	for(std::size_t k: {0u, 1u, 2u, 10u, 1000u, 19999u, 20000u, 30000u}) {
+		const auto top = ph::top_k(v.begin(), ph::untilValue(0), k);
+		const std::size_t expected = std::min<std::size_t>(k, sorted.size());
+		BOOST_REQUIRE_EQUAL(top.size(), expected);
+		BOOST_CHECK(std::equal(top.begin(), top.end(), sorted.begin()));
+	}
+
+	std::list<int> l(v.begin(), v.end());
+	const auto least = ph::top_k(l.begin(), ph::counted(20000), 5, std::greater<int>());
+	BOOST_CHECK(std::equal(least.begin(), least.end(), sorted.rbegin()));
+}
+
+BOOST_AUTO_TEST_CASE(nth_smallest_should_agree_with_nth_element) {
+	std::vector<int> v;
+	for(int i = 0; i < 5000; ++i) {
+		v.push_back((i * 31) % 997);
+	}
+	std::vector<int> sorted(v);
+	std::sort(sorted.begin(), sorted.end());
+
+	for(std::size_t n: {0u, 1u, 500u, 2500u, 4999u}) {
+		BOOST_CHECK_EQUAL(ph::nth_smallest(v.begin(), v.end(), n), sorted[n]);
+		BOOST_CHECK_EQUAL(ph::nth_smallest(v.data(), ph::counted(5000), n, std::greater<int>()), sorted[4999 - n]);
+	}
+	BOOST_CHECK_THROW(ph::nth_smallest(v.begin(), v.end(), 5000), std::out_of_range);
+	BOOST_CHECK_THROW(ph::nth_smallest(v.data(), ph::counted(0), 0), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(sample_should_choose_every_element_equally_often) {
+	std::vector<int> v;
+	for(int i = 1; i <= 100; ++i) {
+		v.push_back(i);
+	}
+	v.push_back(0);
+	std::list<int> l(v.begin(), v.end());
+	std::mt19937 g(42);
+
+	std::vector<int> counts(101, 0);
+	const int trials = 10000;
+	for(int trial = 0; trial < trials; ++trial) {
+		std::vector<int> chosen;
+		switch(trial % 3) {
+		case 0: ph::sample(v.begin(), ph::counted(100), std::back_inserter(chosen), 10, g); break;
+		case 1: ph::sample(v.begin(), ph::untilValue(0), std::back_inserter(chosen), 10, g); break;
+		default: ph::sample(l.begin(), ph::untilValue(0), std::back_inserter(chosen), 10, g); break;
+		}
+		BOOST_REQUIRE_EQUAL(chosen.size(), 10u);
+		std::sort(chosen.begin(), chosen.end());
+		BOOST_REQUIRE(std::adjacent_find(chosen.begin(), chosen.end()) == chosen.end());
+		for(int i: chosen) {
+			++counts[i];
+		}
+	}
+
+	BOOST_CHECK_EQUAL(counts[0], 0);
+	for(int i = 1; i <= 100; ++i) {
+		BOOST_CHECK(counts[i] > 850 && counts[i] < 1150);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(sample_should_take_all_of_a_short_range) {
+	std::mt19937 g(1);
+	std::string chosen;
+	ph::sample("abc", ph::LazyStrIterator{}, std::back_inserter(chosen), 5, g);
+	BOOST_CHECK_EQUAL(chosen, "abc");
+
+	chosen.clear();
+	ph::sample("abcdefgh", ph::LazyStrIterator{}, std::back_inserter(chosen), 0, g);
+	BOOST_CHECK(chosen.empty());
+
+	const std::string text(10000, 'x');
+	chosen.clear();
+	ph::sample(text.c_str(), ph::LazyStrIterator{}, std::back_inserter(chosen), 3, g);
+	BOOST_CHECK_EQUAL(chosen, "xxx");
+}
+
+BOOST_AUTO_TEST_CASE(weighted_sample_should_follow_the_weights) {
+	std::vector<int> v = {1, 2, 3, 0, 4, 0};
+	std::mt19937 g(7);
+
+	std::vector<int> counts(5, 0);
+	for(int trial = 0; trial < 10000; ++trial) {
+		std::vector<int> chosen;
+		ph::weighted_sample(v.begin(), ph::counted(5), std::back_inserter(chosen), 1,
+				[](int i) { return static_cast<double>(i); }, g);
+		BOOST_REQUIRE_EQUAL(chosen.size(), 1u);
+		++counts[chosen[0]];
+	}
+
+	BOOST_CHECK_EQUAL(counts[0], 0);
+	for(int i = 1; i <= 4; ++i) {
+		BOOST_CHECK(counts[i] > i * 1000 * 0.85 && counts[i] < i * 1000 * 1.15);
+	}
+
+	std::vector<int> all;
+	ph::weighted_sample(v.begin(), v.end(), std::back_inserter(all), 10, [](int i) { return i; }, g);
+	std::sort(all.begin(), all.end());
+	auto expected = {1, 2, 3, 4};
+	BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), all.begin(), all.end());
+}
+
+BOOST_AUTO_TEST_CASE(adjacent_find_should_agree_with_std_for_every_end_kind) {
+	for(int at: {0, 1, 62, 63, 64, 65, 127, 128, 500, 998}) {
+		std::vector<int> v;
+		for(int i = 0; i < 1000; ++i) {
+			v.push_back(i);
+		}
+		v[at + 1] = v[at];
+		v.push_back(-1);
+		std::list<int> l(v.begin(), v.end());
+
+		for(int n: {0, 1, at + 1, at + 2, 1000}) {
+			const std::ptrdiff_t expected = std::adjacent_find(v.begin(), v.begin() + n) - v.begin();
+			BOOST_CHECK_EQUAL(ph::adjacent_find(v.data(), ph::counted(n)) - v.data(), expected);
+			BOOST_CHECK_EQUAL(ph::adjacent_find(v.data(), ph::until([&v, n](const int& i) { return &i == v.data() + n; })) - v.data(), expected);
+			BOOST_CHECK_EQUAL(std::distance(l.begin(), ph::adjacent_find(l.begin(), ph::counted(n), std::equal_to<int>())), expected);
+		}
+		BOOST_CHECK_EQUAL(ph::adjacent_find(v.data(), ph::untilValue(-1), std::not_equal_to<>()) - v.data(), at == 0 ? 1 : 0);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(minmax_element_should_stay_within_floats_holding_nan) {
+	float v[] = {NAN, 1, 2};
+	const auto extremes = ph::minmax_element(v, ph::counted(3));
+	BOOST_CHECK(extremes.first >= v && extremes.first < v + 3);
+	BOOST_CHECK(extremes.second >= v && extremes.second < v + 3);
+
+	for(int at: {0, 5, 255, 256, 700, 999}) {
+		std::vector<float> w;
+		for(int i = 0; i < 1000; ++i) {
+			w.push_back(static_cast<float>((i * 37) % 1000));
+		}
+		w[at] = NAN;
+		const auto found = ph::minmax_element(w.data(), ph::counted(1000));
+		BOOST_CHECK(found.first >= w.data() && found.first < w.data() + 1000);
+		BOOST_CHECK(found.second >= w.data() && found.second < w.data() + 1000);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -0,0 +1,85 @@
+#include <boost/test/unit_test.hpp>
+#include "ph.hpp"
+#include "algorithm.hpp"
+#include "DelimiterIndex.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+std::string makeBuffer() {
+	std::string s;
+	for(int i = 0; i < 300; ++i) {
+		s += static_cast<char>('a' + i % 26);
+		if(i % 7 == 0) s += ',';
+		if(i % 11 == 0) s += '\n';
+		if(i % 13 == 0) s += '"';
+	}
+	return s;
+}
+
+} // unnamed namespace
+
+BOOST_AUTO_TEST_SUITE(delimiterIndexTest)
+
+BOOST_AUTO_TEST_CASE(index_next_should_agree_with_scanning_the_bytes) {
+	const std::string s = makeBuffer();
+	const char* b = s.data();
+	const char* e = b + s.size();
+	ph::DelimiterIndex index(b, e, {',', '\n', '"'});
+
+	for(const char* p = b; p <= e; ++p) {
+		BOOST_CHECK_EQUAL(ph::next(p, index.untilValue(',')) - b,
+				std::find(p, e, ',') - b);
+		BOOST_CHECK_EQUAL(ph::next(p, index.untilValue('\n', '"')) - b,
+				ph::next(p, ph::untilValue('\n', '"') || e) - b);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(index_sentinels_should_combine_with_or) {
+	const std::string s = makeBuffer();
+	const char* b = s.data();
+	const char* e = b + s.size();
+	ph::DelimiterIndex index(b, e, {',', '\n', '"'});
+
+	BOOST_CHECK_EQUAL(ph::next(b + 10, index.untilValue('\n') || index.untilValue('"')) - b,
+			ph::next(b + 10, index.untilValue('\n', '"')) - b);
+}
+
+BOOST_AUTO_TEST_CASE(index_find_and_count_should_agree_with_unindexed_versions) {
+	const std::string s = makeBuffer();
+	const char* b = s.data();
+	const char* e = b + s.size();
+	ph::DelimiterIndex index(b, e, {',', '\n', '"'});
+
+	for(const char* p = b; p < e; p += 17) {
+		auto stop = ph::untilValue('"') || e;
+		BOOST_CHECK_EQUAL(ph::find(p, index.untilValue('"'), ',') - b, ph::find(p, stop, ',') - b);
+		BOOST_CHECK_EQUAL(ph::find(p, index.untilValue('"'), 'q') - b, ph::find(p, stop, 'q') - b);
+		BOOST_CHECK_EQUAL(ph::count(p, index.untilValue('"'), ','), ph::count(p, stop, ','));
+		BOOST_CHECK_EQUAL(ph::count(p, index.untilValue('\n'), 'c'),
+				ph::count(p, ph::untilValue('\n') || e, 'c'));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(index_sentinel_should_work_as_a_plain_node) {
+	const std::string s = "ab,cd";
+	ph::DelimiterIndex index(s.data(), s.data() + s.size(), {','});
+
+	BOOST_CHECK_EQUAL(ph::distance(s.data(), index.untilValue(',')), 2);
+	BOOST_CHECK_EQUAL(ph::distance(s.data() + 3, index.untilValue(',')), 2);
+}
+
+BOOST_AUTO_TEST_CASE(index_should_reject_characters_that_were_not_indexed) {
+	const std::string s = "ab,cd;ef";
+	ph::DelimiterIndex index(s.data(), s.data() + s.size(), {','});
+	BOOST_CHECK_THROW(index.untilValue(';'), std::invalid_argument);
+	BOOST_CHECK_THROW(index.untilValue(',', ';'), std::invalid_argument);
+
+	ph::DelimiterIndex none(s.data(), s.data() + s.size(), {});
+	BOOST_CHECK_THROW(none.untilValue(','), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,84 @@
+#include <boost/test/unit_test.hpp>
+#include "ph.hpp"
+#include "algorithm.hpp"
+#include "dynamic_sentinel.hpp"
+
+#include <list>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(dynamicSentinelTest)
+
+BOOST_AUTO_TEST_CASE(dynamic_sentinel_of_values_should_behave_like_untilValue) {
+	std::vector<int> v = { 1, 2, 300, 4, 200, 100 };
+
+	ph::dynamic_sentinel<int> stop("100 || 200");
+
+	BOOST_CHECK(stop.valueSet());
+	BOOST_CHECK(ph::find(v.begin(), stop || v.end(), 7) ==
+			ph::find(v.begin(), ph::untilValue(100, 200) || v.end(), 7));
+	BOOST_CHECK_EQUAL(ph::distance(v.begin(), stop), 4);
+}
+
+BOOST_AUTO_TEST_CASE(dynamic_sentinel_should_honour_precedence_and_negation) {
+	ph::dynamic_sentinel<int> stop("1 || >= 500 && < 600 && !(== 550)");
+
+	BOOST_CHECK(!stop.valueSet());
+	BOOST_CHECK(stop.matches(1));
+	BOOST_CHECK(stop.matches(500));
+	BOOST_CHECK(stop.matches(599));
+	BOOST_CHECK(!stop.matches(550));
+	BOOST_CHECK(!stop.matches(600));
+	BOOST_CHECK(!stop.matches(2));
+
+	ph::dynamic_sentinel<int> grouped("(1 || 2) && != 2");
+	BOOST_CHECK(grouped.matches(1));
+	BOOST_CHECK(!grouped.matches(2));
+}
+
+BOOST_AUTO_TEST_CASE(dynamic_sentinel_should_compose_with_static_nodes) {
+	std::list<int> l = { 5, 6, 7, 8, 9 };
+
+	ph::dynamic_sentinel<int> stop("> 7");
+
+	BOOST_CHECK_EQUAL(ph::count_if(l.begin(), stop || ph::counted(10), [](int) { return true; }), 3);
+	BOOST_CHECK_EQUAL(ph::distance(l.begin(), stop && ph::untilValue(9)), 4);
+	BOOST_CHECK_EQUAL(ph::distance(l.begin(), !ph::dynamic_sentinel<int>("< 8") || l.end()), 3);
+}
+
+BOOST_AUTO_TEST_CASE(dynamic_sentinel_should_reject_malformed_expressions) {
+	BOOST_CHECK_THROW(ph::dynamic_sentinel<int>("1 ||"), std::invalid_argument);
+	BOOST_CHECK_THROW(ph::dynamic_sentinel<int>("(1"), std::invalid_argument);
+	BOOST_CHECK_THROW(ph::dynamic_sentinel<int>("< x"), std::invalid_argument);
+	BOOST_CHECK_THROW(ph::dynamic_sentinel<int>("1 2"), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(dynamic_sentinel_should_handle_long_chains) {
+	std::string values = "0";
+	std::string ranges = "(< 0 || > 0)";
+	for(int i = 1; i < 200000; ++i) {
+		values += " || " + std::to_string(2 * i);
+		ranges += " && != " + std::to_string(i);
+	}
+
+	ph::dynamic_sentinel<int> set(values);
+	BOOST_CHECK(set.valueSet());
+	BOOST_CHECK(set.matches(399998));
+	BOOST_CHECK(!set.matches(399999));
+
+	ph::dynamic_sentinel<int> excluded(ranges);
+	BOOST_CHECK(!excluded.valueSet());
+	BOOST_CHECK(excluded.matches(200000));
+	BOOST_CHECK(!excluded.matches(199999));
+	BOOST_CHECK(!excluded.matches(0));
+}
+
+BOOST_AUTO_TEST_CASE(dynamic_sentinel_should_reject_too_deep_nesting) {
+	BOOST_CHECK_NO_THROW(ph::dynamic_sentinel<int>(std::string(100, '(') + "1" + std::string(100, ')')));
+	BOOST_CHECK_THROW(ph::dynamic_sentinel<int>(std::string(100000, '(') + "1" + std::string(100000, ')')),
+			std::invalid_argument);
+	BOOST_CHECK_THROW(ph::dynamic_sentinel<int>(std::string(100000, '!') + "1"), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
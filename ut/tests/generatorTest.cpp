@@ -0,0 +1,93 @@
+#include <boost/test/unit_test.hpp>
+#include "ph.hpp"
+#include "algorithm.hpp"
+#include "adaptors.hpp"
+#include "generator.hpp"
+
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+
+auto counter(int limit) {
+	int i = 0;
+	return ph::make_generator<int>([i, limit](int& out) mutable {
+		out = i++;
+		return out < limit;
+	});
+}
+
+template<typename Range, typename Adaptor, typename = void>
+struct CanPipe : std::false_type {};
+
+template<typename Range, typename Adaptor>
+struct CanPipe<Range, Adaptor, decltype(void(std::declval<Range>() | std::declval<Adaptor>()))> : std::true_type {};
+
+} // unnamed namespace
+
+BOOST_AUTO_TEST_SUITE(generatorTest)
+
+BOOST_AUTO_TEST_CASE(generator_should_be_walkable_until_exhausted) {
+	auto g = counter(5);
+
+	std::vector<int> visited;
+	ph::for_each(g.begin(), g.end(), [&visited](int i) { visited.push_back(i); });
+
+	auto expected = {0, 1, 2, 3, 4};
+	BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), visited.begin(), visited.end());
+}
+
+BOOST_AUTO_TEST_CASE(empty_generator_should_give_empty_range) {
+	auto g = counter(0);
+
+	BOOST_CHECK_EQUAL(ph::distance(g.begin(), g.end()), 0);
+}
+
+BOOST_AUTO_TEST_CASE(generator_end_should_compose_with_until) {
+	auto g = counter(100);
+
+	auto it = ph::find(g.begin(), ph::untilValue(50) || g.end(), 42);
+	BOOST_CHECK_EQUAL(*it, 42);
+
+	auto g2 = counter(100);
+	BOOST_CHECK_EQUAL(ph::count_if(g2.begin(), ph::untilValue(50) || g2.end(),
+				[](int i) { return i % 2 == 0; }), 25);
+
+	auto g3 = counter(10);
+	BOOST_CHECK(ph::find(g3.begin(), ph::untilValue(50) || g3.end(), 42).done());
+}
+
+BOOST_AUTO_TEST_CASE(generator_should_honour_counted) {
+	auto g = counter(100);
+
+	BOOST_CHECK_EQUAL(ph::count_if(g.begin(), g.end() || ph::counted(10),
+				[](int) { return true; }), 10);
+	BOOST_CHECK_EQUAL(ph::distance(g.begin(), g.end() || ph::counted(5)), 5);
+	BOOST_CHECK_EQUAL(*g.begin(), 15);
+}
+
+BOOST_AUTO_TEST_CASE(generator_should_work_with_filtered) {
+	auto g = counter(10);
+
+	auto range = g | ph::adaptor::filtered([](const int& i) { return i % 3 == 0; });
+
+	std::vector<int> visited;
+	ph::for_each(range.begin(), range.end(), [&visited](int i) { visited.push_back(i); });
+
+	auto expected = {0, 3, 6, 9};
+	BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), visited.begin(), visited.end());
+}
+
+BOOST_AUTO_TEST_CASE(generator_should_only_be_piped_as_an_lvalue) {
+	using Generator = decltype(counter(0));
+	auto isEven = [](const int& i) { return i % 2 == 0; };
+	using Filter = decltype(ph::adaptor::filtered(isEven));
+
+	static_assert(CanPipe<Generator&, Filter>::value, "generators pipe by reference");
+	static_assert(!CanPipe<Generator, Filter>::value, "temporary generators would dangle");
+	static_assert(!CanPipe<Generator, decltype(ph::adaptor::take_until(ph::untilValue(0)))>::value,
+			"temporary generators would dangle");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
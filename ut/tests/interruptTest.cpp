@@ -0,0 +1,90 @@
+#include <boost/test/unit_test.hpp>
+#include "ph.hpp"
+#include "algorithm.hpp"
+#include "interrupt.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <list>
+#include <memory>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(interruptTest)
+
+namespace {
+
+// A handle to a shared state, like std::stop_token.
+struct Token {
+	int stopAfter;
+	std::shared_ptr<int> checks = std::make_shared<int>(0);
+
+	bool stop_requested() const { return ++*checks > stopAfter; }
+};
+
+}
+
+BOOST_AUTO_TEST_CASE(until_cancelled_should_not_cut_off_a_scan_that_is_not_cancelled) {
+	std::vector<int> v(100000, 1);
+	v[77777] = 2;
+	std::atomic<bool> cancelled{false};
+
+	auto stop = ph::until_cancelled(cancelled);
+
+	BOOST_CHECK(ph::find(v.begin(), v.end() || stop, 2) == v.begin() + 77777);
+	BOOST_CHECK_EQUAL(ph::count(v.begin(), v.end() || stop, 1), 99999);
+	BOOST_CHECK(!stop.cut_off());
+}
+
+BOOST_AUTO_TEST_CASE(until_cancelled_should_cut_off_between_blocks) {
+	std::vector<int> v(1000000, 1);
+	std::atomic<bool> cancelled{true};
+
+	auto stop = ph::until_cancelled(cancelled);
+	const auto firstBlock = stop.blockSize();
+	auto it = ph::find(v.begin(), v.end() || stop, 2);
+
+	BOOST_CHECK(stop.cut_off());
+	BOOST_CHECK_EQUAL(it - v.begin(), firstBlock);
+
+	// Once cut off, the node stays so.
+	cancelled = false;
+	BOOST_CHECK(ph::find(v.begin(), v.end() || stop, 2) != v.end());
+}
+
+BOOST_AUTO_TEST_CASE(until_cancelled_should_accept_stop_token_like_objects) {
+	std::list<int> l(100000, 1);
+	Token token{2};
+
+	auto stop = ph::until_cancelled(token);
+	long long sum = 0;
+	ph::for_each(l.begin(), l.end() || stop, [&sum](int i) { sum += i; });
+
+	BOOST_CHECK(stop.cut_off());
+	BOOST_CHECK_EQUAL(*token.checks, 3);
+	BOOST_CHECK(sum > 0 && sum < 100000);
+}
+
+BOOST_AUTO_TEST_CASE(until_cancelled_should_keep_a_temporary_token) {
+	std::vector<int> v(1000000, 1);
+
+	auto stop = ph::until_cancelled(Token{1});
+	auto it = ph::find(v.begin(), v.end() || stop, 2);
+
+	BOOST_CHECK(stop.cut_off());
+	BOOST_CHECK(it != v.end());
+}
+
+BOOST_AUTO_TEST_CASE(until_deadline_should_cut_off_at_the_deadline) {
+	std::vector<int> v(1000, 1);
+	auto stop = ph::until_deadline(std::chrono::steady_clock::now() - std::chrono::seconds(1));
+
+	// The generic algorithms count down per element.
+	BOOST_CHECK(ph::distance(v.begin(), v.end() || stop) < 1000);
+	BOOST_CHECK(stop.cut_off());
+
+	auto later = ph::until_deadline(std::chrono::system_clock::now() + std::chrono::hours(1));
+	BOOST_CHECK_EQUAL(ph::count_if(v.begin(), ph::counted(500) || later, [](int i) { return i == 1; }), 500);
+	BOOST_CHECK(!later.cut_off());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,69 @@
+#include <boost/test/unit_test.hpp>
+#include "ph.hpp"
+#include "numeric.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <list>
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(numericTest)
+
+BOOST_AUTO_TEST_CASE(accumulate_should_fold_in_order_up_to_the_sentinel) {
+	std::vector<std::string> v = {"a", "b", "c", "", "d"};
+
+	BOOST_CHECK_EQUAL(ph::accumulate(v.begin(), ph::untilValue(std::string()), std::string("<")), "<abc");
+	BOOST_CHECK_EQUAL(ph::accumulate(v.begin(), v.end(), std::string(), [](const std::string& acc, const std::string& s) {
+		return s + acc;
+	}), "dcba");
+
+	std::list<int> l = {1, 2, 3, 4};
+	BOOST_CHECK_EQUAL(ph::accumulate(l.begin(), ph::counted(3), 0), 6);
+}
+
+BOOST_AUTO_TEST_CASE(reduce_should_sum_any_length_up_to_the_sentinel) {
+	std::vector<int> v;
+	for(int i = 1; i <= 5000; ++i) {
+		v.push_back(i);
+	}
+	v.push_back(0);
+
+	for(int n: {0, 1, 15, 16, 255, 256, 257, 1000, 4096, 5000}) {
+		const long long expected = static_cast<long long>(n) * (n + 1) / 2;
+		BOOST_CHECK_EQUAL(ph::reduce(v.data(), ph::counted(n), 0LL), expected);
+		BOOST_CHECK_EQUAL(ph::reduce(v.data(), ph::untilValue(n + 1) || ph::untilValue(0), 0LL), expected);
+		BOOST_CHECK_EQUAL(ph::reduce(v.begin(), ph::counted(n), 0LL), expected);
+	}
+
+	BOOST_CHECK_EQUAL(ph::reduce(v.data(), ph::untilValue(0)), 12502500);
+}
+
+BOOST_AUTO_TEST_CASE(reduce_should_use_the_operation_without_an_identity) {
+	std::vector<int> v;
+	for(int i = 0; i < 1000; ++i) {
+		v.push_back((i * 37) % 1001);
+	}
+
+	auto max = [](int a, int b) { return a < b ? b : a; };
+	BOOST_CHECK_EQUAL(ph::reduce(v.data(), v.data() + v.size(), -1, max), *std::max_element(v.begin(), v.end()));
+	BOOST_CHECK_EQUAL(ph::reduce(v.data(), ph::counted(0), -1, max), -1);
+}
+
+BOOST_AUTO_TEST_CASE(transform_reduce_should_match_a_scalar_loop) {
+	std::vector<double> a;
+	std::vector<double> b;
+	for(int i = 0; i < 777; ++i) {
+		a.push_back(i * 0.5);
+		b.push_back(2.0);
+	}
+
+	BOOST_CHECK_CLOSE(ph::transform_reduce(a.data(), ph::counted(777), b.data(), 0.0), 776.0 * 777.0 / 2, 1e-9);
+	BOOST_CHECK_CLOSE(ph::transform_reduce(a.data(), a.data() + 777, 0.0, std::plus<>(), [](double d) { return d * d; }),
+			0.25 * 776.0 * 777.0 * 1553.0 / 6, 1e-9);
+
+	std::list<int> l = {1, 2, 3};
+	BOOST_CHECK_EQUAL(ph::transform_reduce(l.begin(), l.end(), l.begin(), 0), 14);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,95 @@
+#include <boost/test/unit_test.hpp>
+#include "ph.hpp"
+#include "range.hpp"
+#include "adaptors.hpp"
+#include "algorithm.hpp"
+#include "parallel.hpp"
+
+#include <string>
+#include <vector>
+
+namespace {
+
+std::vector<std::string> toStrings(const std::vector<ph::Range<const char*, const char*>>& records) {
+	std::vector<std::string> result;
+	for(const auto& r: records) {
+		result.emplace_back(r.begin(), r.end());
+	}
+	return result;
+}
+
+} // unnamed namespace
+
+BOOST_AUTO_TEST_SUITE(parallelTest)
+
+BOOST_AUTO_TEST_CASE(parallel_split_should_give_the_same_records_as_split_for_any_thread_count) {
+	std::string s;
+	for(int i = 0; i < 200; ++i) {
+		s += std::string(i % 7, 'a' + i % 26);
+		s += i % 3 ? '\n' : ';';
+	}
+	s += "tail";
+
+	auto range = ph::make_iterator_range(s.data(), s.data() + s.size()) |
+		ph::adaptor::split(ph::untilValue('\n', ';'));
+	std::vector<std::string> expected;
+	ph::for_each(range.begin(), range.end(), [&expected](const ph::Range<const char*, const char*>& r) {
+			expected.emplace_back(r.begin(), r.end());
+	});
+
+	for(unsigned threads = 1; threads <= 64; threads *= 2) {
+		auto records = ph::parallel_split(s.data(), s.data() + s.size(),
+				ph::untilValue('\n', ';'), threads);
+		auto actual = toStrings(records);
+		BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(),
+				actual.begin(), actual.end());
+	}
+}
+
+BOOST_AUTO_TEST_CASE(parallel_split_should_stitch_records_straddling_chunk_boundaries) {
+	std::string s = "aaaaaaa\nbbbbbbbbbbbbbbb\nc";
+
+	auto actual = toStrings(ph::parallel_split(s.data(), s.data() + s.size(),
+				ph::untilValue('\n'), 8));
+
+	auto expected = {"aaaaaaa", "bbbbbbbbbbbbbbb", "c"};
+	BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(),
+			actual.begin(), actual.end());
+}
+
+BOOST_AUTO_TEST_CASE(parallel_split_callback_should_see_records_in_order) {
+	std::string s = "0\n1\n2\n3\n4\n5\n6\n7\n8\n9";
+
+	std::string visited;
+	ph::parallel_split(s.data(), s.data() + s.size(), ph::untilValue('\n'), 4,
+			[&visited](const ph::Range<const char*, const char*>& r) {
+				visited.append(r.begin(), r.end());
+	});
+
+	BOOST_CHECK_EQUAL(visited, "0123456789");
+}
+
+BOOST_AUTO_TEST_CASE(parallel_split_of_empty_buffer_should_give_one_empty_record) {
+	const char* s = "";
+
+	auto records = ph::parallel_split(s, s, ph::untilValue('\n'), 4);
+
+	BOOST_REQUIRE_EQUAL(records.size(), 1u);
+	BOOST_CHECK(records[0].begin() == records[0].end());
+}
+
+BOOST_AUTO_TEST_CASE(parallel_reduce_should_give_the_same_sum_for_any_thread_count) {
+	std::vector<int> v;
+	for(int i = 1; i <= 100000; ++i) {
+		v.push_back(i);
+	}
+	v.push_back(0);
+
+	for(unsigned threads = 1; threads <= 64; threads *= 2) {
+		BOOST_CHECK_EQUAL(ph::parallel_reduce(v.data(), ph::untilValue(0), 0LL, threads), 5000050000LL);
+		BOOST_CHECK_EQUAL(ph::parallel_reduce(v.data(), ph::counted(3), 10LL, threads), 16LL);
+		BOOST_CHECK_EQUAL(ph::parallel_reduce(v.data(), ph::counted(0), 10LL, threads), 10LL);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,75 @@
+#include <boost/test/unit_test.hpp>
+#include "ph.hpp"
+#include "scanner.hpp"
+#include "substring.hpp"
+
+#include <list>
+#include <string>
+
+BOOST_AUTO_TEST_SUITE(scannerTest)
+
+BOOST_AUTO_TEST_CASE(scanner_should_not_depend_on_fragmentation) {
+	const std::string input = "HTTP/1.1 200 OK\r\nA: b\r\n\r\nbody";
+
+	for(std::size_t fragment = 1; fragment <= input.size(); ++fragment) {
+		auto s = ph::make_scanner(ph::untilSubstring("\r\n\r\n"));
+		std::size_t fragmentsSeen = 0;
+		std::size_t stopOffset = 0;
+		for(std::size_t at = 0; at < input.size() && !s.found(); at += fragment) {
+			const char* b = input.data() + at;
+			const char* e = input.data() + std::min(input.size(), at + fragment);
+			auto r = s.next(b, e);
+			if(r.found) {
+				stopOffset = r.position - input.data();
+			}
+			++fragmentsSeen;
+		}
+
+		BOOST_REQUIRE(s.found());
+		BOOST_CHECK_EQUAL(s.offset(), static_cast<std::ptrdiff_t>(input.find("body")));
+		BOOST_CHECK_EQUAL(stopOffset, input.find("body"));
+		BOOST_CHECK_EQUAL(s.sentinel().position(), static_cast<std::ptrdiff_t>(input.find("\r\n\r\n")));
+		BOOST_CHECK(fragmentsSeen * fragment <= input.find("body") + fragment);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(scanner_should_find_a_match_ending_with_the_fragment) {
+	const std::string request = "GET / HTTP/1.1\r\nHost: x\r\n\r\n";
+
+	auto s = ph::make_scanner(ph::untilSubstring("\r\n\r\n"));
+	auto r = s.next(request.data(), request.data() + request.size());
+
+	BOOST_CHECK(r.found);
+	BOOST_CHECK(s.found());
+	BOOST_CHECK(r.position == request.data() + request.size());
+	BOOST_CHECK_EQUAL(s.offset(), static_cast<std::ptrdiff_t>(request.size()));
+
+	auto split = ph::make_scanner(ph::untilSubstring("\r\n\r\n"));
+	BOOST_CHECK(!split.next(request.data(), request.data() + 20).found);
+	BOOST_CHECK(split.next(request.data() + 20, request.data() + request.size()).found);
+	BOOST_CHECK_EQUAL(split.offset(), static_cast<std::ptrdiff_t>(request.size()));
+}
+
+BOOST_AUTO_TEST_CASE(scanner_should_resume_stateless_sentinels_over_forward_iterators) {
+	std::list<int> first = { 1, 2, 3 };
+	std::list<int> second = { 4, 5, 6 };
+
+	auto s = ph::make_scanner(ph::untilValue(5));
+
+	auto r1 = s.next(first.begin(), first.end());
+	BOOST_CHECK(!r1.found);
+	BOOST_CHECK(r1.position == first.end());
+	BOOST_CHECK_EQUAL(s.offset(), 3);
+
+	auto r2 = s.next(second.begin(), ph::counted(10));
+	BOOST_CHECK(r2.found);
+	BOOST_CHECK_EQUAL(*r2.position, 5);
+	BOOST_CHECK_EQUAL(s.offset(), 4);
+
+	auto r3 = s.next(first.begin(), first.end());
+	BOOST_CHECK(r3.found);
+	BOOST_CHECK(r3.position == first.begin());
+	BOOST_CHECK_EQUAL(s.offset(), 4);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
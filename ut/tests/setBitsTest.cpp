@@ -0,0 +1,86 @@
+#include <boost/test/unit_test.hpp>
+#include "ph.hpp"
+#include "algorithm.hpp"
+#include "adaptors.hpp"
+#include "set_bits.hpp"
+
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+
+template<typename Words, typename = void>
+struct CanSetBits : std::false_type {};
+
+template<typename Words>
+struct CanSetBits<Words, decltype(void(ph::set_bits(std::declval<Words>())))> : std::true_type {};
+
+} // unnamed namespace
+
+BOOST_AUTO_TEST_SUITE(setBitsTest)
+
+BOOST_AUTO_TEST_CASE(set_bits_should_walk_the_set_positions_in_order) {
+	std::vector<std::uint64_t> words(11, 0);
+	words[0] = 0x5;
+	words[1] = 1ull << 63;
+	words[9] = 0x3;
+	words[10] = 1ull << 40;
+
+	auto bits = ph::set_bits(words);
+	std::vector<std::size_t> visited;
+	ph::for_each(bits.begin(), bits.end(), [&visited](std::size_t i) { visited.push_back(i); });
+
+	std::vector<std::size_t> expected = {0, 2, 127, 576, 577, 680};
+	BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), visited.begin(), visited.end());
+	BOOST_CHECK_EQUAL(ph::distance(bits.begin(), bits.end()), 6);
+}
+
+BOOST_AUTO_TEST_CASE(set_bits_should_only_walk_words_that_outlive_the_range) {
+	static_assert(CanSetBits<std::vector<std::uint64_t>&>::value, "named words are walked in place");
+	static_assert(CanSetBits<const std::vector<std::uint64_t>&>::value, "named words are walked in place");
+	static_assert(!CanSetBits<std::vector<std::uint64_t>>::value, "temporary words would dangle");
+}
+
+BOOST_AUTO_TEST_CASE(set_bits_of_zero_words_should_be_empty) {
+	std::vector<std::uint64_t> words(7, 0);
+	auto bits = ph::set_bits(words);
+	BOOST_CHECK(bits.begin() == bits.end());
+	BOOST_CHECK_EQUAL(ph::distance(bits.begin(), bits.end()), 0);
+
+	std::vector<std::uint64_t> none;
+	auto empty = ph::set_bits(none);
+	BOOST_CHECK(empty.begin() == empty.end());
+}
+
+BOOST_AUTO_TEST_CASE(set_bits_should_stop_at_an_until_on_the_position) {
+	std::vector<std::uint64_t> words(4, 0x8000000000000001ull);
+	auto bits = ph::set_bits(words);
+
+	auto below = [](std::size_t i) { return i > 100; };
+	BOOST_CHECK_EQUAL(ph::distance(bits.begin(), ph::until(below) || bits.end()), 3);
+
+	auto it = ph::find(bits.begin(), bits.end(), 191u);
+	BOOST_CHECK_EQUAL(*it, 191u);
+	BOOST_CHECK_EQUAL(ph::distance(it, bits.end()), 3);
+
+	BOOST_CHECK_EQUAL(ph::distance(bits.begin(), ph::counted(5) || bits.end()), 5);
+	BOOST_CHECK_EQUAL(ph::distance(bits.begin(), bits.end() || ph::untilValue(256u)), 8);
+}
+
+BOOST_AUTO_TEST_CASE(set_bits_should_compose_with_filtered_and_count) {
+	std::vector<std::uint64_t> words(3, 0xFFull);
+	auto bits = ph::set_bits(words);
+
+	BOOST_CHECK_EQUAL(ph::count_if(bits.begin(), bits.end(), [](std::size_t i) { return i % 2 == 0; }), 12);
+
+	auto odd = bits | ph::adaptor::filtered([](std::size_t i) { return i % 2 == 1; });
+	std::vector<std::size_t> visited;
+	ph::for_each(odd.begin(), odd.end(), [&visited](std::size_t i) { visited.push_back(i); });
+	BOOST_REQUIRE_EQUAL(visited.size(), 12u);
+	BOOST_CHECK_EQUAL(visited.front(), 1u);
+	BOOST_CHECK_EQUAL(visited.back(), 135u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,96 @@
+#include <boost/test/unit_test.hpp>
+#include "ph.hpp"
+#include "algorithm.hpp"
+#include "range.hpp"
+#include "LazyStrIterator.hpp"
+#include "substring.hpp"
+
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(substringTest)
+
+BOOST_AUTO_TEST_CASE(untilSubstring_should_stop_after_the_first_match) {
+	const std::string request = "GET / HTTP/1.1\r\nHost: x\r\n\r\nbody\r\n\r\n";
+
+	auto stop = ph::untilSubstring("\r\n\r\n");
+	auto bodyBegin = ph::next(request.begin(), request.end() || stop);
+
+	BOOST_REQUIRE(stop.matched());
+	BOOST_CHECK_EQUAL(stop.pattern(), 0u);
+	BOOST_CHECK_EQUAL(stop.position(), static_cast<std::ptrdiff_t>(request.find("\r\n\r\n")));
+	BOOST_CHECK_EQUAL(std::string(bodyBegin, request.end()), "body\r\n\r\n");
+}
+
+BOOST_AUTO_TEST_CASE(untilSubstring_should_report_which_pattern_matched_first) {
+	const char* text = "xx</record>--boundary";
+
+	auto stop = ph::untilSubstring("--boundary", std::string("</record>"), "zz");
+	std::string copied;
+	ph::copy(text, ph::LazyStrIterator{} || stop, std::back_inserter(copied));
+
+	BOOST_REQUIRE(stop.matched());
+	BOOST_CHECK_EQUAL(stop.pattern(), 1u);
+	BOOST_CHECK_EQUAL(stop.patternString(), "</record>");
+	BOOST_CHECK_EQUAL(stop.position(), 2);
+	BOOST_CHECK_EQUAL(copied, "xx</record>");
+}
+
+BOOST_AUTO_TEST_CASE(untilSubstring_should_prefer_the_longest_of_the_matches_ending_together) {
+	const char* text = "abcde";
+
+	auto stop = ph::untilSubstring("cd", "bcd");
+	ph::next(text, ph::LazyStrIterator{} || stop);
+
+	BOOST_CHECK_EQUAL(stop.patternString(), "bcd");
+	BOOST_CHECK_EQUAL(stop.position(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(untilSubstring_should_reject_empty_patterns) {
+	BOOST_CHECK_THROW(ph::untilSubstring("\r\n", ""), std::invalid_argument);
+	BOOST_CHECK_THROW(ph::untilSubstring(std::string()), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(untilSubstring_with_many_patterns_should_agree_with_strstr) {
+	std::vector<std::string> words;
+	for(int i = 0; i < 40; ++i) {
+		words.push_back("word" + std::to_string(i * 7919 % 1000));
+	}
+	std::string text;
+	for(int i = 0; i < 2000; ++i) {
+		text += "w0rd" + std::to_string(i) + " ";
+	}
+	text += words[17] + " " + words[3];
+
+	// Far more than the 64 bytes shift-or handles.
+	ph::SubstringNode stop(words);
+	auto it = ph::next(text.c_str(), ph::LazyStrIterator{} || stop);
+
+	BOOST_REQUIRE(stop.matched());
+	BOOST_CHECK_EQUAL(stop.patternString(), words[17]);
+	BOOST_CHECK_EQUAL(stop.position(), static_cast<std::ptrdiff_t>(text.find(words[17])));
+	BOOST_CHECK_EQUAL(it - text.c_str(), stop.position() + static_cast<std::ptrdiff_t>(words[17].size()));
+}
+
+BOOST_AUTO_TEST_CASE(untilSubstring_should_find_matches_spanning_buffers) {
+	const std::string first = "abc--bou";
+	const std::string second = "ndaryrest";
+
+	auto stop = ph::untilSubstring("--boundary");
+	BOOST_CHECK(ph::next(first.begin(), first.end() || stop) == first.end());
+	BOOST_CHECK(!stop.matched());
+
+	auto it = ph::next(second.begin(), second.end() || stop);
+	BOOST_REQUIRE(stop.matched());
+	BOOST_CHECK_EQUAL(stop.position(), 3);
+	BOOST_CHECK_EQUAL(std::string(it, second.end()), "rest");
+
+	stop.reset();
+	BOOST_CHECK(!stop.matched());
+	BOOST_CHECK(ph::next(second.begin(), second.end() || stop) == second.end());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -6,6 +6,9 @@
 #include <algorithm>
 #include <cstring>
 #include <functional>
+#include <list>
+#include <string>
+#include "LazyStrIterator.hpp"
 
 BOOST_AUTO_TEST_SUITE(mainTests)
 
@@ -341,5 +344,126 @@ BOOST_AUTO_TEST_CASE(find_not_operator_works_when_it_doesnt_get_reached) {
 	BOOST_CHECK_EQUAL(it - v1.begin(), 5);
 }
 
+BOOST_AUTO_TEST_CASE(counted_should_bound_find_on_random_access_iterators) {
+	std::vector<int> v = { 1, 2, 3, 4, 5, 6 };
+
+	auto it = ph::find(v.begin(), ph::untilValue(9) || ph::counted(3), 5);
+
+	BOOST_CHECK(it == v.begin() + 3);
+}
+
+BOOST_AUTO_TEST_CASE(counted_should_bound_find_on_forward_iterators) {
+	std::list<int> l = { 1, 2, 3, 4, 5, 6 };
+
+	auto it = ph::find(l.begin(), ph::untilValue(9) || ph::counted(3), 5);
+
+	BOOST_CHECK(it == std::next(l.begin(), 3));
+	BOOST_CHECK(ph::find(l.begin(), ph::until_n(5), 3) == std::next(l.begin(), 2));
+}
+
+BOOST_AUTO_TEST_CASE(counted_should_not_fire_if_the_delimiter_comes_first) {
+	std::list<int> l = { 1, 2, 3, 4, 5, 6 };
+	std::vector<int> v(l.begin(), l.end());
+
+	BOOST_CHECK_EQUAL(ph::count(l.begin(), ph::untilValue(4) || ph::counted(5), 1), 1);
+	BOOST_CHECK_EQUAL(ph::distance(l.begin(), ph::untilValue(4) || ph::counted(5)), 3);
+	BOOST_CHECK_EQUAL(ph::distance(v.begin(), ph::untilValue(4) || ph::counted(5)), 3);
+}
+
+BOOST_AUTO_TEST_CASE(counted_should_count_correctly_below_and_and_not) {
+	std::list<int> l = { 2, 3, 4, 5, 6, 7, 9 };
+
+	auto isOdd = ph::until([](const int& i) { return i % 2 == 1; });
+
+	BOOST_CHECK_EQUAL(ph::distance(l.begin(), (isOdd && !ph::counted(3)) || l.end()), 1);
+	BOOST_CHECK_EQUAL(ph::distance(l.begin(), (isOdd && ph::counted(3)) || l.end()), 3);
+	BOOST_CHECK_EQUAL(ph::distance(l.begin(), (isOdd && ph::counted(6)) || l.end()), 6);
+	BOOST_CHECK(ph::all_of(l.begin(), ph::counted(1), [](int i) { return i % 2 == 0; }));
+	BOOST_CHECK(!ph::all_of(l.begin(), ph::counted(2), [](int i) { return i % 2 == 0; }));
+}
+
+BOOST_AUTO_TEST_CASE(counted_should_make_the_char_scan_stop_at_the_budget) {
+	std::string s(100, 'x');
+	s[50] = '\n';
+
+	BOOST_CHECK_EQUAL(ph::next(s.c_str(), ph::untilValue('\n') || ph::counted(20)), s.c_str() + 20);
+	BOOST_CHECK_EQUAL(ph::next(s.c_str(), ph::untilValue('\n') || ph::counted(80)), s.c_str() + 50);
+	BOOST_CHECK_EQUAL(ph::next(s.c_str() + 60, ph::LazyStrIterator{} || ph::counted(1000)), s.c_str() + 100);
+}
+
+BOOST_AUTO_TEST_CASE(counted_should_allow_a_budget_larger_than_the_data) {
+	std::vector<char> v = { 'a', 'b', '\n', 'c' };
+	const char* s = "ab\ncd";
+
+	BOOST_CHECK(ph::find(v.begin(), ph::untilValue('\n') || ph::counted(4096), 'b') == v.begin() + 1);
+	BOOST_CHECK(ph::find(v.begin(), ph::untilValue('\n') || ph::counted(4096), 'c') == v.begin() + 2);
+	BOOST_CHECK_EQUAL(ph::count(v.data(), ph::untilValue('\n') || ph::counted(4096), 'a'), 1);
+	BOOST_CHECK_EQUAL(ph::next(s, ph::untilValue('\n') || ph::counted(4096)), s + 2);
+}
+
+BOOST_AUTO_TEST_CASE(four_iterator_equal_should_require_both_ranges_to_end_together) {
+	std::vector<int> v1 = { 1, 2, 3, 0, 9 };
+	std::vector<int> v2 = { 1, 2, 3, 4, 0 };
+
+	BOOST_CHECK(ph::equal(v1.begin(), ph::untilValue(0), v2.begin(), ph::untilValue(4)));
+	BOOST_CHECK(!ph::equal(v1.begin(), ph::untilValue(0), v2.begin(), ph::untilValue(0)));
+	BOOST_CHECK(!ph::equal(v1.begin(), v1.end(), v2.begin(), v2.end()));
+	BOOST_CHECK(ph::equal(v1.begin(), ph::untilValue(0), v2.begin(), ph::untilValue(4),
+				std::equal_to<int>()));
+}
+
+BOOST_AUTO_TEST_CASE(four_iterator_mismatch_should_stop_at_the_shorter_range) {
+	std::list<int> l = { 1, 2, 3, 0 };
+	std::vector<int> v = { 1, 2, 3, 4, 5 };
+
+	auto m = ph::mismatch(l.begin(), ph::untilValue(0), v.begin(), v.end());
+	BOOST_CHECK(m.first == std::next(l.begin(), 3));
+	BOOST_CHECK(m.second == v.begin() + 3);
+
+	auto m2 = ph::mismatch(v.begin(), ph::counted(2), l.begin(), ph::untilValue(0));
+	BOOST_CHECK(m2.first == v.begin() + 2);
+
+	auto m3 = ph::mismatch(v.begin(), v.end(), l.begin(), [](int a, int b) { return a <= b; });
+	BOOST_CHECK(m3.first == v.begin() + 3);
+}
+
+BOOST_AUTO_TEST_CASE(c_string_mismatch_should_behave_like_strcmp_at_every_alignment) {
+	std::string s1(100, 'x');
+	std::string s2(100, 'x');
+
+	for(std::size_t offset1 = 0; offset1 < 17; ++offset1) {
+		for(std::size_t offset2 = 0; offset2 < 17; ++offset2) {
+			for(std::size_t diff: {0u, 5u, 40u, 80u}) {
+				std::string a = s1.substr(offset1);
+				std::string b = s2.substr(offset2);
+				if(diff < a.size() && diff < b.size()) {
+					b[diff] = 'y';
+				}
+				const char* pa = a.c_str();
+				const char* pb = b.c_str();
+
+				auto m = ph::mismatch(pa, ph::LazyStrIterator{}, pb, ph::LazyStrIterator{});
+				std::size_t expected = 0;
+				while(pa[expected] && pa[expected] == pb[expected]) {
+					++expected;
+				}
+				BOOST_CHECK_EQUAL(m.first - pa, static_cast<std::ptrdiff_t>(expected));
+				BOOST_CHECK_EQUAL(m.second - pb, static_cast<std::ptrdiff_t>(expected));
+				BOOST_CHECK_EQUAL(ph::equal(pa, ph::LazyStrIterator{}, pb, ph::LazyStrIterator{}),
+						std::strcmp(pa, pb) == 0);
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(c_string_equal_should_respect_value_delimiters) {
+	const char* a = "key=value";
+	const char* b = "key:other";
+
+	BOOST_CHECK(ph::equal(a, ph::untilValue('=') || ph::LazyStrIterator{},
+				b, ph::untilValue(':') || ph::LazyStrIterator{}));
+	BOOST_CHECK(!ph::equal(a, ph::LazyStrIterator{}, b, ph::LazyStrIterator{}));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -0,0 +1,77 @@
+#include <boost/test/unit_test.hpp>
+#include "ph.hpp"
+#include "algorithm.hpp"
+#include "ValueSet.hpp"
+
+#include <cstdint>
+#include <list>
+#include <set>
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(valueSetTest)
+
+namespace {
+
+template<typename T>
+void checkAgainstStdSet(const std::vector<T>& values, const std::vector<T>& probes, ph::ValueSetRepresentation representation) {
+	const std::set<T> expected(values.begin(), values.end());
+	const ph::ValueSet<T> set(values.begin(), values.end(), representation);
+	for(const T& v: probes) {
+		BOOST_CHECK_EQUAL(set.contains(v), expected.count(v) == 1);
+	}
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(ValueSet_should_pick_representation_from_spread) {
+	std::vector<int> dense = { 3, 1, 4, 1, 5, 9, 2, 6 };
+	std::vector<std::int64_t> sparse = { -7, 1ll << 40, 123456789, 42 };
+	std::vector<std::string> strings = { "a", "b" };
+
+	BOOST_CHECK(ph::ValueSet<int>(dense.begin(), dense.end()).representation() == ph::ValueSetRepresentation::Bitmap);
+	BOOST_CHECK(ph::ValueSet<std::int64_t>(sparse.begin(), sparse.end()).representation() == ph::ValueSetRepresentation::Hash);
+	BOOST_CHECK(ph::ValueSet<std::string>(strings.begin(), strings.end()).representation() == ph::ValueSetRepresentation::Sorted);
+	BOOST_CHECK(ph::ValueSet<std::string>(strings.begin(), strings.end(), ph::ValueSetRepresentation::Hash).representation() == ph::ValueSetRepresentation::Sorted);
+}
+
+BOOST_AUTO_TEST_CASE(ValueSet_representations_should_agree_with_std_set) {
+	std::vector<int> values;
+	std::uint32_t x = 12345;
+	for(int i = 0; i < 5000; ++i) {
+		x = x * 1664525u + 1013904223u;
+		values.push_back(static_cast<int>(x % 200000) - 100000);
+	}
+	std::vector<int> probes(values.begin(), values.begin() + 1000);
+	for(int i = -100010; i < 100010; i += 97) {
+		probes.push_back(i);
+	}
+
+	for(auto r: { ph::ValueSetRepresentation::Bitmap, ph::ValueSetRepresentation::Hash, ph::ValueSetRepresentation::Sorted }) {
+		checkAgainstStdSet(values, probes, r);
+		checkAgainstStdSet(std::vector<int>{ 7 }, std::vector<int>{ 6, 7, 8 }, r);
+		checkAgainstStdSet(std::vector<int>{}, std::vector<int>{ 0, 1 }, r);
+	}
+	checkAgainstStdSet(std::vector<std::string>{ "x", "yy", "zzz" }, std::vector<std::string>{ "", "x", "y", "yy", "zzzz" },
+			ph::ValueSetRepresentation::Auto);
+}
+
+BOOST_AUTO_TEST_CASE(untilAnyOf_should_stop_at_any_value_of_the_set) {
+	std::list<int> l = { 10, 20, 30, 40, 50 };
+	std::vector<int> stops = { 40, 1000, 30 };
+
+	BOOST_CHECK_EQUAL(ph::distance(l.begin(), ph::untilAnyOf(stops) || l.end()), 2);
+	BOOST_CHECK_EQUAL(ph::distance(l.begin(), ph::untilAnyOf<int, 50, 60>() || l.end()), 4);
+	BOOST_CHECK_EQUAL(ph::distance(l.begin(), ph::untilAnyOf(std::vector<int>{ 1 }) || l.end()), 5);
+	BOOST_CHECK(*ph::find(l.begin(), ph::untilAnyOf(stops) || l.end(), 20) == 20);
+}
+
+BOOST_AUTO_TEST_CASE(untilAnyOf_should_compose_with_counted) {
+	std::vector<int> v = { 1, 2, 3, 4, 5, 6 };
+	auto stop = ph::untilAnyOf(std::vector<int>{ 5, 6 });
+
+	BOOST_CHECK_EQUAL(ph::distance(v.begin(), stop || ph::counted(2)), 2);
+	BOOST_CHECK_EQUAL(ph::distance(v.begin(), stop || ph::counted(10)), 4);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
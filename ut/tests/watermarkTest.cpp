@@ -0,0 +1,73 @@
+#include <boost/test/unit_test.hpp>
+#include "ph.hpp"
+#include "algorithm.hpp"
+#include "watermark.hpp"
+
+#include <thread>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(watermarkTest)
+
+BOOST_AUTO_TEST_CASE(watermark_sentinel_without_waiting_should_stop_at_the_published_length) {
+	std::vector<int> data = { 1, 2, 3, 4, 5 };
+	ph::Watermark w;
+
+	BOOST_CHECK_EQUAL(ph::distance(data.begin(), ph::make_watermark_sentinel(data.begin(), w, ph::WatermarkWait::None)), 0);
+
+	w.publish(3);
+	BOOST_CHECK_EQUAL(ph::distance(data.begin(), ph::make_watermark_sentinel(data.begin(), w, ph::WatermarkWait::None)), 3);
+	BOOST_CHECK(ph::find(data.begin(), ph::make_watermark_sentinel(data.begin(), w, ph::WatermarkWait::None), 5) == data.begin() + 3);
+
+	w.publish(5);
+	w.close();
+	BOOST_CHECK_EQUAL(ph::distance(data.begin(), ph::make_watermark_sentinel(data.begin(), w)), 5);
+}
+
+BOOST_AUTO_TEST_CASE(watermark_sentinel_should_follow_a_producer_until_closed) {
+	const std::size_t size = 200000;
+	std::vector<long long> data(size);
+	ph::Watermark w;
+
+	std::thread producer([&data, &w, size]() {
+		for(std::size_t i = 0; i < size; ++i) {
+			data[i] = static_cast<long long>(i);
+			if(i % 1000 == 999) {
+				w.publish(i + 1);
+			}
+		}
+		w.publish(size);
+		w.close();
+	});
+
+	std::vector<long long> sums(3);
+	std::vector<std::thread> consumers;
+	const ph::WatermarkWait policies[] = { ph::WatermarkWait::Spin, ph::WatermarkWait::Yield, ph::WatermarkWait::Block };
+	for(std::size_t c = 0; c < sums.size(); ++c) {
+		consumers.emplace_back([&data, &w, &sums, &policies, c]() {
+			ph::for_each(data.begin(), ph::make_watermark_sentinel(data.begin(), w, policies[c]),
+					[&sums, c](long long i) { sums[c] += i; });
+		});
+	}
+
+	producer.join();
+	for(auto& t: consumers) {
+		t.join();
+	}
+
+	const long long expected = static_cast<long long>(size) * (size - 1) / 2;
+	for(long long sum: sums) {
+		BOOST_CHECK_EQUAL(sum, expected);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(watermark_sentinel_should_compose_with_other_nodes) {
+	std::vector<int> data = { 1, 2, 3, 4, 5 };
+	ph::Watermark w;
+	w.publish(5);
+
+	std::thread closer([&w]() { w.close(); });
+	BOOST_CHECK_EQUAL(ph::distance(data.begin(), ph::make_watermark_sentinel(data.begin(), w) || ph::untilValue(4)), 3);
+	closer.join();
+}
+
+BOOST_AUTO_TEST_SUITE_END()